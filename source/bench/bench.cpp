@@ -0,0 +1,326 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <cxxopts.hpp>
+#include <cxxproperties.hpp>
+
+#include "../src/problem/problem.h"
+#include "../src/util/common.h"
+#include "../src/algorithm/heuristic/greedy.h"
+#include "../src/algorithm/heuristic/ils.h"
+#include "../src/algorithm/heuristic/neh.h"
+#include "../src/neighborhood/shift.h"
+#include "../src/neighborhood/exchange.h"
+#include "../src/neighborhood/reassignment.h"
+#include "../src/neighborhood/swap.h"
+#include "../src/neighborhood/direct_swap.h"
+
+
+/*
+ * Function statements.
+ */
+
+cxxopts::Options init_parser(int argc, char** argv);
+
+std::vector<double> parse_list(const std::string& text);
+
+void generate_instance(const std::string& filename, int n, int m, double density, unsigned seed);
+
+double throughput(double min_time, const std::function<void()>& task);
+
+
+/*
+ * Main function.
+ */
+
+int main(int argc, char** argv) {
+
+    try {
+
+        // Initialize the command-line parser
+        cxxopts::Options options = init_parser(argc, argv);
+
+        // Show help message, if requested
+        if (options.count("help") > 0) {
+            std::cout << options.help({""}) << std::endl;
+            return EXIT_SUCCESS;
+        }
+
+        // Benchmark settings
+        auto sizes = parse_list(options["sizes"].as<std::string>());
+        auto teams = parse_list(options["teams"].as<std::string>());
+        auto densities = parse_list(options["densities"].as<std::string>());
+        auto seed = options["seed"].as<unsigned>();
+        auto min_time = options["min-time"].as<double>();
+        auto ils_iterations = options["ils-iterations"].as<long>();
+
+        // Directory of the generated instances
+        auto directory = std::filesystem::temp_directory_path() / ("schd_bench_" + std::to_string(seed));
+        std::filesystem::create_directories(directory);
+
+        // Run the benchmark on each point of the grid
+        std::ostringstream json;
+        json << "{\n  \"min_time\": " << min_time << ",\n  \"seed\": " << seed << ",\n  \"instances\": [";
+
+        bool first = true;
+        for (auto n : sizes) {
+            for (auto m : teams) {
+                for (auto density : densities) {
+
+                    // Generate and load the instance
+                    std::string filename = (directory / orcs::common::format("n%d_m%d_d%g.txt",
+                            static_cast<int>(n), static_cast<int>(m), density)).string();
+                    generate_instance(filename, static_cast<int>(n), static_cast<int>(m), density, seed);
+                    orcs::Problem problem(filename);
+
+                    // Solution used as reference
+                    auto [schedule, makespan] = orcs::Greedy().solve(problem);
+                    auto entry = std::make_tuple(schedule, orcs::common::evaluate(problem, schedule));
+
+                    // Evaluations per second
+                    double start_time_rate = throughput(min_time, [&]() {
+                        problem.start_time(schedule);
+                    });
+
+                    double evaluate_rate = throughput(min_time, [&]() {
+                        orcs::common::evaluate(problem, schedule);
+                    });
+
+                    // Neighbors per second of each neighborhood
+                    std::vector< std::pair<std::string, orcs::Neighborhood*> > neighborhoods = {
+                            {"shift", new orcs::Shift()},
+                            {"exchange", new orcs::Exchange()},
+                            {"reassignment", new orcs::Reassignment()},
+                            {"direct_swap", new orcs::DirectSwap()},
+                            {"swap", new orcs::Swap()}
+                    };
+
+                    std::ostringstream json_neighborhoods;
+                    for (std::size_t k = 0; k < neighborhoods.size(); ++k) {
+                        auto [name, neighborhood] = neighborhoods[k];
+
+                        long count = 0;
+                        for (int block = 0; block < neighborhood->blocks(problem); ++block) {
+                            neighborhood->moves(problem, schedule, block, [&count](const orcs::Move& move) {
+                                ++count;
+                                return true;
+                            });
+                        }
+
+                        double best_rate = throughput(min_time, [&]() {
+                            neighborhood->best(problem, entry);
+                        });
+
+                        json_neighborhoods << (k > 0 ? ",\n" : "")
+                                           << "        \"" << name << "\": {\"neighbors\": " << count
+                                           << ", \"best_per_sec\": " << best_rate
+                                           << ", \"neighbors_per_sec\": " << best_rate * count << "}";
+
+                        delete neighborhood;
+                    }
+
+                    // Time per ILS iteration (the time of the start solution
+                    // and first local search is discounted)
+                    auto ils_runtime = [&](long iterations) {
+                        cxxproperties::Properties opt_input;
+                        cxxproperties::Properties opt_output;
+                        opt_input.add("seed", seed);
+                        opt_input.add("iterations-limit", iterations);
+                        opt_input.add("perturbation-passes-limit", std::numeric_limits<long>::max());
+                        auto start = std::chrono::steady_clock::now();
+                        orcs::ILS().solve(problem, &opt_input, &opt_output);
+                        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+                        return std::make_tuple(elapsed.count(), opt_output.get<long>("Iterations"));
+                    };
+
+                    auto [time_base, iterations_base] = ils_runtime(0);
+                    auto [time_total, iterations_total] = ils_runtime(ils_iterations);
+                    double ils_iteration_time = (iterations_total > 0 ?
+                            std::max(0.0, time_total - time_base) / iterations_total : 0.0);
+
+                    // Time of the NEH-based heuristic
+                    auto neh_start = std::chrono::steady_clock::now();
+                    orcs::NEH().solve(problem);
+                    double neh_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - neh_start).count();
+
+                    // Write the results
+                    json << (first ? "\n" : ",\n")
+                         << "    {\n"
+                         << "      \"n\": " << problem.n << ",\n"
+                         << "      \"m\": " << problem.m << ",\n"
+                         << "      \"density\": " << density << ",\n"
+                         << "      \"start_time_per_sec\": " << start_time_rate << ",\n"
+                         << "      \"evaluate_per_sec\": " << evaluate_rate << ",\n"
+                         << "      \"neighborhoods\": {\n" << json_neighborhoods.str() << "\n      },\n"
+                         << "      \"ils_iterations\": " << iterations_total << ",\n"
+                         << "      \"ils_seconds_per_iteration\": " << ils_iteration_time << ",\n"
+                         << "      \"neh_seconds\": " << neh_time << "\n"
+                         << "    }";
+
+                    first = false;
+                }
+            }
+        }
+
+        json << "\n  ]\n}\n";
+        std::cout << json.str();
+
+        // Remove the generated instances
+        std::filesystem::remove_all(directory);
+
+    } catch (const std::string& e) {
+        std::cerr << e << std::endl;
+        std::cerr << "Type the following command for a correct usage." << std::endl;
+        std::cerr << argv[0] << " --help" << std::endl << std::endl;
+        return EXIT_FAILURE;
+
+    } catch (...) {
+        std::cerr << "Unexpected error." << std::endl;
+        std::cerr << "Type the following command for a correct usage." << std::endl;
+        std::cerr << argv[0] << " --help" << std::endl << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/*
+ * Function definitions.
+ */
+
+cxxopts::Options init_parser(int argc, char** argv) {
+
+    cxxopts::Options options(argv[0], "Maneuver Scheduling Problem (benchmark of the hot paths)");
+
+    options.add_options("")
+            ("h,help", "Show this help message and exit.",
+             cxxopts::value<bool>(), "")
+
+            ("sizes", "Comma-separated list of numbers of switches.",
+             cxxopts::value<std::string>()->default_value("25,50,100"), "LIST")
+
+            ("teams", "Comma-separated list of numbers of teams.",
+             cxxopts::value<std::string>()->default_value("2,4"), "LIST")
+
+            ("densities", "Comma-separated list of probabilities of a precedence arc between two switches.",
+             cxxopts::value<std::string>()->default_value("0.01,0.05"), "LIST")
+
+            ("seed", "Seed used to generate the instances and run the ILS.",
+             cxxopts::value<unsigned>()->default_value("0"), "VALUE")
+
+            ("min-time", "Minimum time (in seconds) spent measuring each throughput.",
+             cxxopts::value<double>()->default_value("0.5"), "VALUE")
+
+            ("ils-iterations", "Number of ILS iterations used to measure the time per iteration.",
+             cxxopts::value<long>()->default_value("5"), "VALUE");
+
+    options.parse(argc, argv);
+    return options;
+}
+
+std::vector<double> parse_list(const std::string& text) {
+    std::vector<double> values;
+    std::stringstream stream(text);
+    std::string token;
+    while (std::getline(stream, token, ',')) {
+        try {
+            values.push_back(std::stod(token));
+        } catch (...) {
+            throw std::string("Invalid list of values: \"" + text + "\".");
+        }
+    }
+
+    return values;
+}
+
+void generate_instance(const std::string& filename, int n, int m, double density, unsigned seed) {
+
+    // Random number generator
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<int> maneuver_time(1, 10);
+    std::uniform_int_distribution<int> travel_time(1, 20);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    // Random order of the switches (the precedence arcs follow this order)
+    std::vector<int> order(n);
+    for (int i = 0; i < n; ++i) {
+        order[i] = i + 1;
+    }
+
+    std::shuffle(order.begin(), order.end(), generator);
+
+    // Switches: 10% of them are remotely maneuverable
+    std::vector<char> technology(n + 1, 'M');
+    std::vector<int> p(n + 1, 0);
+    for (int i = 1; i <= n; ++i) {
+        technology[i] = (uniform(generator) < 0.1 ? 'R' : 'M');
+        p[i] = (technology[i] == 'R' ? 1 : maneuver_time(generator));
+    }
+
+    // Precedence arcs
+    std::vector< std::vector<int> > predecessors(n + 1);
+    for (int a = 0; a < n; ++a) {
+        for (int b = a + 1; b < n; ++b) {
+            if (uniform(generator) < density) {
+                predecessors[order[b]].push_back(order[a]);
+            }
+        }
+    }
+
+    // Write the file
+    std::ofstream file(filename.c_str());
+    if (!file.is_open()) {
+        throw std::string("File \"" + filename + "\" cannot be opened for writing.");
+    }
+
+    file << n << " " << m << " " << density << "\n\n";
+    for (int i = 1; i <= n; ++i) {
+        file << i << " " << technology[i] << " " << p[i] << "\n";
+    }
+
+    file << "\n";
+    for (int j = 1; j <= n; ++j) {
+        file << j << " " << predecessors[j].size();
+        for (auto i : predecessors[j]) {
+            file << " " << i;
+        }
+        file << "\n";
+    }
+
+    for (int l = 1; l <= m; ++l) {
+        file << "\n";
+        for (int i = 0; i <= n; ++i) {
+            for (int j = 0; j <= n; ++j) {
+                file << (i == j ? 0 : travel_time(generator)) << (j < n ? " " : "\n");
+            }
+        }
+    }
+
+    file.close();
+}
+
+double throughput(double min_time, const std::function<void()>& task) {
+    long count = 0;
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed(0.0);
+    while (elapsed.count() < min_time || count == 0) {
+        task();
+        ++count;
+        elapsed = std::chrono::steady_clock::now() - start;
+    }
+
+    return count / elapsed.count();
+}
@@ -0,0 +1,169 @@
+#include "grasp.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <list>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <cxxtimer.hpp>
+
+#include "greedy.h"
+#include "../../util/common.h"
+#include "../../util/local_search.h"
+#include "../../util/thread_pool.h"
+#include "../../neighborhood/shift.h"
+#include "../../neighborhood/exchange.h"
+#include "../../neighborhood/reassignment.h"
+#include "../../neighborhood/swap.h"
+#include "../../neighborhood/direct_swap.h"
+
+
+std::tuple<orcs::Schedule, double> orcs::GRASP::solve(const Problem& problem,
+        const cxxproperties::Properties* opt_input, cxxproperties::Properties* opt_output) {
+
+    // Algorithm parameters
+    cxxproperties::Properties opt_aux;
+    if (opt_input == nullptr) {
+        opt_input = &opt_aux;
+    }
+
+    const unsigned seed = opt_input->get<unsigned>("seed", 0);
+    const double time_limit = opt_input->get<double>("time-limit", std::numeric_limits<double>::max());
+    const int threads = opt_input->get<int>("threads", 1);
+    const long starts = std::max(1L, opt_input->get<long>("grasp-starts", 100));
+    const double alpha = opt_input->get<double>("alpha", 0.1);
+    const long elite_size = std::max(1L, opt_input->get<long>("grasp-elite", 4));
+    const std::string local_search_method = opt_input->get<std::string>("local-search-method", "vnd"); // vnd, rvnd
+    const std::string local_search_approach = opt_input->get<std::string>("local-search-approach", "best"); // best, first, sampled
+    const long sample_size = opt_input->get<long>("neighborhood-sample-size", 1000);
+
+    // Local search method and approach to explore the neighborhoods
+    bool randomized_vnd = local_search_method.compare("rvnd") == 0;
+    const Approach approach = local_search::approach(local_search_approach);
+
+    // Thread pool used by both phases
+    ThreadPool pool(threads);
+
+    // Initialize a timer
+    cxxtimer::Timer timer;
+    timer.start();
+
+    // Construction phase: each start has its own seed, derived from the seed
+    // of the algorithm, so the results do not depend on the number of threads
+    std::vector< std::tuple<Schedule, std::tuple<double, double> > > constructions(starts);
+    std::vector<char> built(starts, 0);
+
+    pool.run(static_cast<int>(starts), [&](int k) {
+        if (k > 0 && timer.count<std::chrono::seconds>() >= time_limit) {
+            return;
+        }
+
+        std::seed_seq sequence = {seed, static_cast<unsigned>(k)};
+        std::vector<unsigned> start_seed(1);
+        sequence.generate(start_seed.begin(), start_seed.end());
+
+        cxxproperties::Properties opt_greedy;
+        opt_greedy.add("alpha", alpha);
+        opt_greedy.add("seed", start_seed[0]);
+
+        auto schedule = std::get<0>(Greedy().solve(problem, &opt_greedy));
+        constructions[k] = std::make_tuple(schedule, common::evaluate(problem, schedule));
+        built[k] = 1;
+    });
+
+    // Elite: the best distinct schedules built (ties are broken by the order
+    // of the starts)
+    std::vector<long> order;
+    for (long k = 0; k < starts; ++k) {
+        if (built[k]) {
+            order.push_back(k);
+        }
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&constructions](long a, long b) {
+        return common::less(std::get<1>(constructions[a]), std::get<1>(constructions[b]));
+    });
+
+    std::vector<long> elite;
+    for (auto k : order) {
+        if (static_cast<long>(elite.size()) >= elite_size) {
+            break;
+        }
+
+        bool duplicate = false;
+        for (auto e : elite) {
+            duplicate = duplicate || std::get<0>(constructions[e]) == std::get<0>(constructions[k]);
+        }
+
+        if (!duplicate) {
+            elite.push_back(k);
+        }
+    }
+
+    // Improvement phase: local search from each elite schedule. When the
+    // time limit is reached, the local searches not started yet are skipped
+    // and their schedules are kept as built.
+    std::vector< std::tuple<Schedule, std::tuple<double, double> > > improved(elite.size());
+    std::atomic<long> searches(0);
+
+    pool.run(static_cast<int>(elite.size()), [&](int k) {
+        improved[k] = constructions[elite[k]];
+        if (k > 0 && timer.count<std::chrono::seconds>() >= time_limit) {
+            return;
+        }
+
+        ++searches;
+
+        // Define the list of neighborhoods used by the VND
+        std::list<Neighborhood*> neighborhoods = {
+                new Shift(),
+                new Exchange(),
+                new Reassignment(),
+                new DirectSwap(),
+                new Swap()
+        };
+
+        // Its own stream, after those of the starts, derived from the seed of
+        // the algorithm as in the construction phase
+        std::seed_seq sequence = {seed, static_cast<unsigned>(starts + k)};
+        std::mt19937 generator(sequence);
+        for (auto ptr : neighborhoods) {
+            ptr->set_approach(approach, &generator, sample_size);
+        }
+
+        improved[k] = randomized_vnd ? local_search::rvnd(problem, constructions[elite[k]], neighborhoods, &generator) :
+                      local_search::vnd(problem, constructions[elite[k]], neighborhoods);
+
+        // Deallocate resources
+        for (auto ptr : neighborhoods) {
+            delete ptr;
+        }
+    });
+
+    // Best solution found
+    std::size_t best = 0;
+    for (std::size_t k = 1; k < improved.size(); ++k) {
+        if (common::less(std::get<1>(improved[k]), std::get<1>(improved[best]))) {
+            best = k;
+        }
+    }
+
+    // Stop timer
+    timer.stop();
+
+    // Store optional output
+    if (opt_output != nullptr) {
+        opt_output->add("Starts", order.size());
+        opt_output->add("Elite", elite.size());
+        opt_output->add("Local searches", searches.load());
+        opt_output->add("Best start solution", std::get<0>(std::get<1>(constructions[order.front()])));
+        opt_output->add("Runtime (s)", timer.count<std::chrono::milliseconds>() / 1000.0);
+        opt_output->add("Threads", pool.size());
+    }
+
+    // Return the solution built
+    return {std::get<0>(improved[best]), std::get<0>(std::get<1>(improved[best]))};
+}
@@ -2,104 +2,194 @@
 
 #include <algorithm>
 #include <cmath>
+#include <functional>
 #include <limits>
+#include <queue>
 #include <random>
+#include <utility>
+#include <vector>
 
 
 std::tuple<orcs::Schedule, double> orcs::Greedy::solve(const Problem& problem,
         const cxxproperties::Properties* opt_input, cxxproperties::Properties* opt_output) {
 
+    // Algorithm parameters
+    cxxproperties::Properties opt_aux;
+    if (opt_input == nullptr) {
+        opt_input = &opt_aux;
+    }
+
+    const double alpha = opt_input->get<double>("alpha", 0.0);
+    const unsigned seed = opt_input->get<unsigned>("seed", 0);
+
+    // Random number generator (only used if alpha > 0)
+    std::mt19937 generator(seed);
+    std::vector< std::pair<int, int> > rcl;
+
     // Create an empty schedule
     Schedule schedule = create_empty_schedule(problem.m);
     double makespan = 0.0;
 
     // Initialize the heuristic data
-    std::set<int> S_manual;
-    std::set<int> S_remote;
+    std::size_t unscheduled = 0;
     std::vector<double> t(problem.n + 1, 0.0);
     std::vector<int> gamma(problem.n + 1, 0);
     std::vector<int> phi(problem.m + 1, 0);
 
+    // Remotely controlled switches ready to be scheduled. They are scheduled
+    // in passes of increasing index: a switch released by another one with
+    // a greater index waits for the next pass.
+    using MinHeap = std::priority_queue<int, std::vector<int>, std::greater<int> >;
+    MinHeap remote_pass;
+    MinHeap remote_next;
+
+    // Manually controlled switches ready to be scheduled (and their positions
+    // in the list)
+    std::vector<int> ready;
+    std::vector<int> ready_position(problem.n + 1, -1);
+
+    // Best ready switch of each team, by criterion and then by index. The
+    // criterion of a switch for a team is the moment the team can start it,
+    // ignoring its predecessors.
+    using Candidate = std::pair<double, int>;
+    const Candidate none(std::numeric_limits<double>::max(), std::numeric_limits<int>::max());
+    std::vector<Candidate> best(problem.m + 1, none);
+
+    auto criterion = [&](int j, int l) -> double {
+        return t[phi[l]] + problem.p[phi[l]] + problem.setup(phi[l], j, l);
+    };
+
+    auto update_best = [&](int l) {
+        best[l] = none;
+        for (auto j : ready) {
+            best[l] = std::min(best[l], Candidate(criterion(j, l), j));
+        }
+    };
+
+    auto release = [&](int j, int releaser) {
+        if (problem.technology[j] == Technology::REMOTE) {
+            (j > releaser ? remote_pass : remote_next).push(j);
+
+        } else if (problem.technology[j] == Technology::MANUAL) {
+            ready_position[j] = static_cast<int>(ready.size());
+            ready.push_back(j);
+            for (int l = 1; l <= problem.m; ++l) {
+                best[l] = std::min(best[l], Candidate(criterion(j, l), j));
+            }
+        }
+    };
+
     for (int i = 1; i <= problem.n; ++i) {
         gamma[i] = problem.predecessors[i].size();
-        if (problem.technology[i] == Technology::MANUAL) {
-            S_manual.insert(i);
-        } else if (problem.technology[i] == Technology::REMOTE) {
-            S_remote.insert(i);
+        if (problem.technology[i] == Technology::MANUAL || problem.technology[i] == Technology::REMOTE) {
+            ++unscheduled;
+            if (gamma[i] == 0) {
+                release(i, 0);
+            }
         }
     }
 
     // Assignment and sequencing
-    while (S_manual.size() + S_remote.size() > 0) {
+    while (unscheduled > 0) {
 
         // Remotely controlled switches
-        bool stop = false;
-        while (!stop) {
-            stop = true;
-            auto j = S_remote.begin();
-            while (j != S_remote.end()) {
-
-                if (gamma[*j] == 0) {
+        while (!remote_pass.empty() || !remote_next.empty()) {
+            if (remote_pass.empty()) {
+                std::swap(remote_pass, remote_next);
+            }
 
-                    t[*j] = 0;
-                    for (auto i : problem.predecessors[*j]) {
-                        t[*j] = std::max(t[*j], t[i] + problem.p[i]);
-                    }
+            int j = remote_pass.top();
+            remote_pass.pop();
 
-                    for (auto i : problem.successors[*j]) {
-                        --gamma[i];
-                    }
+            t[j] = 0;
+            for (auto i : problem.predecessors[j]) {
+                t[j] = std::max(t[j], t[i] + problem.p[i]);
+            }
 
-                    schedule[0].push_back(*j);
-                    j = S_remote.erase(j);
-                    stop = false;
+            // Update the makespan
+            makespan = std::max(makespan, t[j] + problem.p[j]);
 
-                } else {
-                    ++j;
+            for (auto i : problem.successors[j]) {
+                if (--gamma[i] == 0) {
+                    release(i, j);
                 }
             }
+
+            schedule[0].push_back(j);
+            --unscheduled;
         }
 
         // Manually controlled switches
-        if (S_manual.size() > 0) {
+        if (!ready.empty()) {
 
             // Choose a switch and a maintenance team
-            double criterion = std::numeric_limits<double>::max();
-            int j, l;
+            int l = 1;
+            for (int l_trial = 2; l_trial <= problem.m; ++l_trial) {
+                if (best[l_trial] < best[l]) {
+                    l = l_trial;
+                }
+            }
+
+            int j = best[l].second;
 
-            for (auto j_trial : S_manual) {
-                if (gamma[j_trial] == 0) {
+            // Randomized choice: any pair of switch and team whose criterion
+            // is within alpha of the range of the criteria
+            if (alpha > 0.0) {
+                double criterion_min = best[l].first;
+                double criterion_max = criterion_min;
+                for (auto i : ready) {
                     for (int l_trial = 1; l_trial <= problem.m; ++l_trial) {
-                        double criterion_trial = t[phi[l_trial]] + problem.p[phi[l_trial]] + problem.s[phi[l_trial]][j_trial][l_trial];
-                        if (criterion_trial < criterion) {
-                            criterion = criterion_trial;
-                            j = j_trial;
-                            l = l_trial;
+                        criterion_max = std::max(criterion_max, criterion(i, l_trial));
+                    }
+                }
+
+                double threshold = criterion_min + alpha * (criterion_max - criterion_min);
+                rcl.clear();
+                for (auto i : ready) {
+                    for (int l_trial = 1; l_trial <= problem.m; ++l_trial) {
+                        if (criterion(i, l_trial) <= threshold) {
+                            rcl.emplace_back(i, l_trial);
                         }
                     }
                 }
+
+                std::tie(j, l) = rcl[generator() % rcl.size()];
             }
 
             // Compute the moment in which the  maneuver will be performed
-            t[j] = t[phi[l]] + problem.p[phi[l]] + problem.s[phi[l]][j][l];
+            t[j] = t[phi[l]] + problem.p[phi[l]] + problem.setup(phi[l], j, l);
             for (auto i : problem.predecessors[j]) {
                 t[j] = std::max(t[j], t[i] + problem.p[i]);
             }
 
-            // Update the counter of predecessors not scheduled
-            for (auto i : problem.successors[j]) {
-                --gamma[i];
-            }
+            // Remove the switch from the set of unscheduled ones
+            ready[ready_position[j]] = ready.back();
+            ready_position[ready.back()] = ready_position[j];
+            ready.pop_back();
+            ready_position[j] = -1;
+            --unscheduled;
 
             // Update team's data
             schedule[l].push_back(j);
             phi[l] = j;
 
+            // Find the best switches of the team (its criteria changed) and
+            // of the teams whose best switch was taken
+            for (int l_trial = 1; l_trial <= problem.m; ++l_trial) {
+                if (l_trial == l || best[l_trial].second == j) {
+                    update_best(l_trial);
+                }
+            }
+
+            // Update the counter of predecessors not scheduled
+            for (auto i : problem.successors[j]) {
+                if (--gamma[i] == 0) {
+                    release(i, 0);
+                }
+            }
+
             // Update the makespan
             makespan = std::max(makespan, t[j] + problem.p[j]);
-
-            // Remove the switch from the set of unscheduled ones
-            S_manual.erase(j);
         }
     }
 
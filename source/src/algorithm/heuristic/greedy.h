@@ -10,6 +10,17 @@ namespace orcs {
      * A simple greedy heuristic for the maneuver scheduling problem in the
      * restoration of electric power distribution networks. This greedy heuristic
      * is based on the earliest start time (EST) rule.
+     *
+     * The switches whose predecessors are scheduled are kept in a ready list,
+     * and the best of them for each team is kept up to date as switches are
+     * released, so each step only reevaluates the team that received the
+     * last switch (and the teams whose best switch it was).
+     *
+     * If the input argument "alpha" is positive, the heuristic is randomized
+     * as in the construction phase of GRASP: at each step, the switch and the
+     * team are chosen at random among the pairs whose criterion is at most
+     * min + alpha * (max - min). The random number generator is initialized
+     * with the input argument "seed".
      */
     class Greedy : public Algorithm {
 
@@ -1,14 +1,24 @@
 #include "ils.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
 #include <limits>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include <cxxtimer.hpp>
 
 #include "greedy.h"
 #include "../../util/common.h"
 #include "../../util/local_search.h"
+#include "../../util/thread_pool.h"
 #include "../../neighborhood/shift.h"
 #include "../../neighborhood/exchange.h"
 #include "../../neighborhood/reassignment.h"
@@ -31,23 +41,48 @@ std::tuple<orcs::Schedule, double> orcs::ILS::solve(const Problem& problem,
     const long iterations_limit = opt_input->get<long>("iterations-limit", std::numeric_limits<long>::max());
     const long perturbation_passes_limit = opt_input->get<long>("perturbation-passes-limit", 5);
     const std::string local_search_method = opt_input->get<std::string>("local-search-method", "vnd"); // vnd, rvnd
-    const std::string local_search_approach = opt_input->get<std::string>("local-search-approach", "best"); // first, best
+    const std::string local_search_approach = opt_input->get<std::string>("local-search-approach", "best"); // best, first, sampled
+    const long sample_size = opt_input->get<long>("neighborhood-sample-size", 1000);
+    int threads = opt_input->get<int>("threads", 1);
+    const int neighborhood_threads = opt_input->get<int>("neighborhood-threads", 1);
+    const long evaluation_cache_size = opt_input->get<long>("evaluation-cache", 0);
+    const std::string initial_solution = opt_input->get<std::string>("initial-solution", "");
+    const std::string acceptance = opt_input->get<std::string>("acceptance", "better"); // better, random-walk, annealing
+    const double acceptance_temperature = opt_input->get<double>("acceptance-temperature", 0.01);
+    const double acceptance_cooling = opt_input->get<double>("acceptance-cooling", 0.99);
+    const std::string restart_policy = opt_input->get<std::string>("restart-policy", "random"); // best, random
+    const long restarts_limit = opt_input->get<long>("restarts-limit", 0);
+    const double restart_alpha = opt_input->get<double>("alpha", 0.1);
+
+    // Abort, if the acceptance criterion or the restart policy is invalid
+    if (acceptance != "better" && acceptance != "random-walk" && acceptance != "annealing") {
+        throw std::string("Invalid acceptance criterion \"" + acceptance + "\".");
+    }
 
-    // Initialize the random number generator
-    std::mt19937 generator;
-    generator.seed(seed);
+    if (restart_policy != "best" && restart_policy != "random") {
+        throw std::string("Invalid restart policy \"" + restart_policy + "\".");
+    }
 
-    // Local search method
+    // Number of workers (0 means all threads available)
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Local search method and approach to explore the neighborhoods
     bool randomized_vnd = local_search_method.compare("rvnd") == 0;
+    const Approach approach = local_search::approach(local_search_approach);
 
-    // Define the list of neighborhoods used by the VND
-    std::list<Neighborhood*> neighborhoods = {
-            new Shift(),
-            new Exchange(),
-            new Reassignment(),
-            new DirectSwap(),
-            new Swap()
-    };
+    // Thread pool used to scan the neighborhoods (shared by all workers)
+    std::unique_ptr<ThreadPool> pool;
+    if (neighborhood_threads != 1) {
+        pool = std::make_unique<ThreadPool>(neighborhood_threads);
+    }
+
+    // Cache of evaluations (shared by all workers)
+    std::unique_ptr<EvaluationCache> cache;
+    if (evaluation_cache_size > 0) {
+        cache = std::make_unique<EvaluationCache>(problem, evaluation_cache_size);
+    }
 
     // Initialize a timer
     cxxtimer::Timer timer;
@@ -56,59 +91,240 @@ std::tuple<orcs::Schedule, double> orcs::ILS::solve(const Problem& problem,
     // Log: header
     log_header(verbose);
 
-    // Build a start solution with a greedy heuristic
-    auto [start_schedule, start_makespan] = Greedy().solve(problem);
+    // Build a start solution with a greedy heuristic (or read it from a file)
+    Schedule start_schedule;
+    double start_makespan;
+    if (initial_solution.empty()) {
+        std::tie(start_schedule, start_makespan) = Greedy().solve(problem);
+    } else {
+        start_schedule = common::read_solution(initial_solution, problem);
+        start_makespan = problem.makespan(start_schedule);
+    }
+
     auto start = std::make_tuple(start_schedule, common::evaluate(problem, start_schedule));
 
     // Log the initial solution (before LS)
     log_start(std::get<1>(start), timer.count<std::chrono::milliseconds>() / 1000.0, verbose);
 
-    // Find a local optimum from the start solution
-    auto incumbent = randomized_vnd ? local_search::rvnd(problem, start, neighborhoods, &generator) :
-                     local_search::vnd(problem, start, neighborhoods);
+    // Data shared by the workers. The makespan of the best solution found is
+    // kept in an atomic variable, so workers only lock the mutex when they
+    // may have improved the best solution.
+    std::tuple<Schedule, std::tuple<double, double> > best = start;
+    std::atomic<double> best_makespan(std::numeric_limits<double>::infinity());
+    std::mutex best_mutex;
+    bool best_found = false;
+    std::mutex log_mutex;
+    std::atomic<long> iterations(0);
+    std::atomic<long> iteration_last_improvement(0);
+    std::atomic<long> restarts_total(0);
+    std::atomic<bool> stop(false);
+
+    // Names of the neighborhoods (in the order they are used by the VND)
+    const std::vector<std::string> neighborhood_names = {"shift", "exchange", "reassignment", "direct-swap", "swap"};
+
+    // Update the best solution found by all workers. The neighborhood is the
+    // position of the one that made the last improving move (-1 if none, in
+    // which case the origin of the solution is written to the trace).
+    auto update_best = [&](const std::tuple<Schedule, std::tuple<double, double> >& entry, long iteration,
+            int worker_id, int neighborhood, const char* origin) {
+        if (common::less_or_equal(std::get<0>(std::get<1>(entry)), best_makespan.load())) {
+            std::lock_guard<std::mutex> lock(best_mutex);
+            if (!best_found || common::less(std::get<1>(entry), std::get<1>(best))) {
+                best = entry;
+                best_found = true;
+                best_makespan.store(std::get<0>(std::get<1>(entry)));
+                iteration_last_improvement.store(iteration);
+
+                if (improvement_callback_) {
+                    improvement_callback_(std::get<0>(entry), std::get<1>(entry));
+                }
 
-    // Log the initial solution (after LS)
-    log_iteration(0L, std::get<1>(start), std::get<1>(start), std::get<1>(incumbent),
-                  timer.count<std::chrono::milliseconds>() / 1000.0, verbose);
+                if (trace_writer_ != nullptr) {
+                    TraceWriter::Event event;
+                    event.instance = trace_instance_;
+                    event.seed = static_cast<int>(seed);
+                    event.time = timer.count<std::chrono::milliseconds>() / 1000.0;
+                    event.iteration = iteration;
+                    event.worker = worker_id;
+                    event.makespan = std::get<0>(std::get<1>(entry));
+                    event.sum_completions = std::get<1>(std::get<1>(entry));
+                    event.neighborhood = neighborhood >= 0 ? neighborhood_names[neighborhood] : origin;
+                    trace_writer_->record(std::move(event));
+                }
+            }
+        }
+    };
+
+    // Run an ILS. Each worker has its own random number generator and
+    // neighborhoods, and stops on its own stopping criteria or when any
+    // worker reaches the time limit.
+    auto worker = [&](std::mt19937& generator, int worker_id) {
+
+        // Define the list of neighborhoods used by the VND
+        std::list<Neighborhood*> neighborhoods = {
+                new Shift(),
+                new Exchange(),
+                new Reassignment(),
+                new DirectSwap(),
+                new Swap()
+        };
+
+        for (auto ptr : neighborhoods) {
+            ptr->set_thread_pool(pool.get());
+            ptr->set_evaluation_cache(cache.get());
+            ptr->set_approach(approach, &generator, sample_size);
+        }
 
-    // Start the iterative process
-    long iteration = 0;
-    long perturbation_passes = 1;
-    long iteration_last_improvement = 0;
+        // Neighborhood of the last improving move of each local search
+        int improving = -1;
 
-    while (iteration < iterations_limit &&
-           timer.count<std::chrono::seconds>() < time_limit &&
-           perturbation_passes <= perturbation_passes_limit) {
+        // Find a local optimum from the start solution
+        auto incumbent = randomized_vnd ? local_search::rvnd(problem, start, neighborhoods, &generator, &improving) :
+                         local_search::vnd(problem, start, neighborhoods, &improving);
 
-        // Increment the iteration counter
-        ++iteration;
+        update_best(incumbent, 0L, worker_id, improving, "start");
 
-        // Perturbation phase
-        auto perturbed = perturb(problem, incumbent, generator);
-        for (long i = 1; i < perturbation_passes; ++i) {
-            perturbed = perturb(problem, perturbed, generator);
+        // Log the initial solution (after LS)
+        {
+            std::lock_guard<std::mutex> lock(log_mutex);
+            log_iteration(0L, std::get<1>(start), std::get<1>(start), std::get<1>(incumbent),
+                          timer.count<std::chrono::milliseconds>() / 1000.0, verbose);
         }
 
-        // Local search
-        auto trial = randomized_vnd ? local_search::rvnd(problem, start, neighborhoods, &generator) :
-                     local_search::vnd(problem, start, neighborhoods);
+        // Best solution found by this worker (the incumbent may be worse
+        // than it if the acceptance criterion is not "better")
+        auto worker_best = std::get<1>(incumbent);
+
+        // Temperature of the annealing-like acceptance, relative to the
+        // makespan of the first local optimum
+        double temperature = acceptance_temperature * std::get<0>(std::get<1>(incumbent));
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
 
-        // Log: status at current iteration
-        log_iteration(iteration, std::get<1>(incumbent), std::get<1>(perturbed),
-                      std::get<1>(trial), timer.count<std::chrono::milliseconds>() / 1000.0, verbose);
+        // Start the iterative process
+        long perturbation_passes = 1;
+        long restarts = 0;
 
-        // Check for improvements
-        if (common::less(std::get<1>(trial), std::get<1>(incumbent))) {
-            incumbent = std::move(trial);
-            iteration_last_improvement = iteration;
+        while (!stop.load() && !interrupted_.load()) {
 
-            // Reset the perturbation level
-            perturbation_passes = 1;
+            // Restart the search if no improvement is found with the highest
+            // perturbation strength (or stop, if the limit of restarts is
+            // reached)
+            if (perturbation_passes > perturbation_passes_limit) {
+                if (restarts >= restarts_limit) {
+                    break;
+                }
+
+                ++restarts;
+                ++restarts_total;
+                perturbation_passes = 1;
+
+                if (restart_policy == "best") {
+                    std::lock_guard<std::mutex> lock(best_mutex);
+                    incumbent = best;
+
+                } else {
+                    cxxproperties::Properties opt_greedy;
+                    opt_greedy.add("alpha", restart_alpha);
+                    opt_greedy.add("seed", static_cast<unsigned>(generator()));
+
+                    auto schedule = std::get<0>(Greedy().solve(problem, &opt_greedy));
+                    auto restarted = std::make_tuple(schedule, common::evaluate(problem, schedule));
+                    incumbent = randomized_vnd ? local_search::rvnd(problem, restarted, neighborhoods, &generator, &improving) :
+                                local_search::vnd(problem, restarted, neighborhoods, &improving);
+
+                    update_best(incumbent, iterations.load(), worker_id, improving, "restart");
+                }
+
+                worker_best = std::get<1>(incumbent);
+            }
+
+            // Check the time limit
+            if (timer.count<std::chrono::seconds>() >= time_limit) {
+                stop.store(true);
+                break;
+            }
+
+            // Increment the iteration counter
+            long iteration = ++iterations;
+            if (iteration > iterations_limit) {
+                break;
+            }
+
+            // Perturbation phase
+            auto perturbed = perturb(problem, incumbent, generator, cache.get());
+            for (long i = 1; i < perturbation_passes; ++i) {
+                perturbed = perturb(problem, perturbed, generator, cache.get());
+            }
 
-        } else {
+            // Local search
+            auto trial = randomized_vnd ? local_search::rvnd(problem, perturbed, neighborhoods, &generator, &improving) :
+                         local_search::vnd(problem, perturbed, neighborhoods, &improving);
 
-            // Increase the perturbation level
-            ++perturbation_passes;
+            // Log: status at current iteration
+            {
+                std::lock_guard<std::mutex> lock(log_mutex);
+                log_iteration(iteration, std::get<1>(incumbent), std::get<1>(perturbed),
+                              std::get<1>(trial), timer.count<std::chrono::milliseconds>() / 1000.0, verbose);
+            }
+
+            // Check for improvements
+            bool improved = common::less(std::get<1>(trial), worker_best);
+            if (improved) {
+                worker_best = std::get<1>(trial);
+                update_best(trial, iteration, worker_id, improving, "perturbation");
+            }
+
+            // Acceptance criterion
+            bool accepted = common::less(std::get<1>(trial), std::get<1>(incumbent));
+            if (!accepted && acceptance == "random-walk") {
+                accepted = true;
+
+            } else if (!accepted && acceptance == "annealing") {
+                double delta = std::get<0>(std::get<1>(trial)) - std::get<0>(std::get<1>(incumbent));
+                accepted = temperature > 0.0 && uniform(generator) < std::exp(-delta / temperature);
+            }
+
+            temperature *= acceptance_cooling;
+
+            if (accepted) {
+                incumbent = std::move(trial);
+            }
+
+            // Reset the perturbation level if the best solution of the worker
+            // was improved or increase it otherwise
+            perturbation_passes = improved ? 1 : perturbation_passes + 1;
+        }
+
+        // Deallocate resources
+        for (auto ptr : neighborhoods) {
+            delete ptr;
+        }
+    };
+
+    if (threads == 1) {
+
+        // Sequential ILS
+        std::mt19937 generator;
+        generator.seed(seed);
+        worker(generator, 0);
+
+    } else {
+
+        // Parallel ILS: independent runs with random number generators
+        // derived from the seed
+        std::vector<std::mt19937> generators;
+        for (int k = 0; k < threads; ++k) {
+            std::seed_seq sequence = {seed, static_cast<unsigned>(k)};
+            generators.emplace_back(sequence);
+        }
+
+        std::vector<std::thread> pool;
+        for (int k = 0; k < threads; ++k) {
+            pool.emplace_back(worker, std::ref(generators[k]), k);
+        }
+
+        for (auto& thread : pool) {
+            thread.join();
         }
     }
 
@@ -120,22 +336,37 @@ std::tuple<orcs::Schedule, double> orcs::ILS::solve(const Problem& problem,
 
     // Store optional output
     if (opt_output != nullptr) {
-        opt_output->add("Iterations", iteration);
+        opt_output->add("Iterations", std::min(iterations.load(), iterations_limit));
         opt_output->add("Runtime (s)", timer.count<std::chrono::milliseconds>() / 1000.0);
         opt_output->add("Start solution", start_makespan);
-        opt_output->add("Iteration of last improvement", iteration_last_improvement);
-    }
+        opt_output->add("Iteration of last improvement", iteration_last_improvement.load());
+        opt_output->add("Restarts", restarts_total.load());
+        opt_output->add("Threads", threads);
 
-    // Deallocate resources
-    for (auto ptr : neighborhoods) {
-        delete ptr;
+        if (cache != nullptr) {
+            opt_output->add("Evaluation cache hits", cache->hits());
+            opt_output->add("Evaluation cache misses", cache->misses());
+        }
     }
 
     // Return the solution built
-    return {std::get<0>(incumbent), std::get<0>(std::get<1>(incumbent))};
+    return {std::get<0>(best), std::get<0>(std::get<1>(best))};
 }
 
-std::tuple<orcs::Schedule, std::tuple<double, double> > orcs::ILS::perturb(const Problem& problem, const std::tuple<orcs::Schedule, std::tuple<double, double> >& entry, std::mt19937& generator) {
+void orcs::ILS::set_improvement_callback(ImprovementCallback callback) {
+    improvement_callback_ = std::move(callback);
+}
+
+void orcs::ILS::interrupt() {
+    interrupted_.store(true);
+}
+
+void orcs::ILS::set_trace_writer(TraceWriter* writer, const std::string& instance) {
+    trace_writer_ = writer;
+    trace_instance_ = instance;
+}
+
+std::tuple<orcs::Schedule, std::tuple<double, double> > orcs::ILS::perturb(const Problem& problem, const std::tuple<orcs::Schedule, std::tuple<double, double> >& entry, std::mt19937& generator, EvaluationCache* cache) {
 
     // Create a copy of the original entry
     auto perturbed = entry;
@@ -145,6 +376,9 @@ std::tuple<orcs::Schedule, std::tuple<double, double> > orcs::ILS::perturb(const
     std::vector<int> indexes;
     std::vector<int> chain;
 
+    // Hash of the perturbed schedule (if evaluations are cached)
+    std::uint64_t key = (cache != nullptr ? cache->hash(schedule) : 0);
+
     // Initialize and shuffle the chain (order of teams to perform the ejection chain)
     for (int l = 1; l <= problem.m; ++l) {
         chain.push_back(l);
@@ -165,6 +399,7 @@ std::tuple<orcs::Schedule, std::tuple<double, double> > orcs::ILS::perturb(const
             int idx_origin = generator() % schedule[l_origin].size();
             int operation = schedule[l_origin][idx_origin];
             schedule[l_origin].erase(schedule[l_origin].begin() + idx_origin);
+            std::uint64_t removal = (cache != nullptr ? cache->insertion(schedule[l_origin], l_origin, idx_origin, operation) : 0);
 
             // Fill the possible indexes
             indexes.clear();
@@ -179,14 +414,26 @@ std::tuple<orcs::Schedule, std::tuple<double, double> > orcs::ILS::perturb(const
             for (auto idx_target : indexes) {
 
                 // Perform the movement
+                std::uint64_t current_key = 0;
+                if (cache != nullptr) {
+                    current_key = key ^ removal ^ cache->insertion(schedule[l_target], l_target, idx_target, operation);
+                }
+
                 schedule[l_target].insert(schedule[l_target].begin() + idx_target, operation);
 
                 // Evaluate the movement
-                auto current_evaluation = orcs::common::evaluate(problem, schedule);
+                std::tuple<double, double> current_evaluation;
+                if (cache == nullptr || !cache->find(current_key, current_evaluation)) {
+                    current_evaluation = orcs::common::evaluate(problem, schedule);
+                    if (cache != nullptr) {
+                        cache->insert(current_key, current_evaluation);
+                    }
+                }
 
                 // Check for feasibility
                 if (std::get<0>(current_evaluation) != std::numeric_limits<double>::infinity()) {
                     evaluation = std::move(current_evaluation);
+                    key = current_key;
                     success = true;
                     break;
 
@@ -1,8 +1,13 @@
 #ifndef MANEUVER_SCHEDULING_ILS_H
 #define MANEUVER_SCHEDULING_ILS_H
 
+#include <atomic>
+#include <functional>
 #include <random>
+#include <string>
 #include "../algorithm.h"
+#include "../../util/evaluation_cache.h"
+#include "../../util/trace_writer.h"
 
 
 namespace orcs {
@@ -10,6 +15,10 @@ namespace orcs {
     /**
      * This class implements an ILS-based heuristic for the maneuver scheduling
      * problem in the restoration of electric power distribution networks.
+     * The solution to perturb is chosen by an acceptance criterion ("better",
+     * "random-walk" or "annealing"), and a worker may restart from the best
+     * solution found or from a randomized greedy solution when the highest
+     * perturbation strength fails to improve its best solution.
      */
     class ILS : public Algorithm {
     public:
@@ -33,9 +42,54 @@ namespace orcs {
                 const cxxproperties::Properties* opt_input = nullptr,
                 cxxproperties::Properties* opt_output = nullptr);
 
+        /**
+         * Function called whenever the best solution found is improved. It
+         * receives the schedule and its evaluation (makespan and sum of
+         * completion times). Calls are serialized, even if the ILS runs on
+         * multiple threads.
+         */
+        using ImprovementCallback = std::function<void(const Schedule&, const std::tuple<double, double>&)>;
+
+        /**
+         * Set the function called whenever the best solution found is
+         * improved.
+         *
+         * @param   callback
+         *          The function (it can be empty).
+         */
+        void set_improvement_callback(ImprovementCallback callback);
+
+        /**
+         * Request the ILS to stop. It can be called from another thread while
+         * solve() is running; the best solution found so far is returned. If
+         * called before solve(), the ILS stops right after the first local
+         * search.
+         */
+        void interrupt();
+
+        /**
+         * Set the sink of the improvements of the best solution found. Each
+         * event has the time, the iteration, the worker and the neighborhood
+         * of the last improving move of the local search ("perturbation",
+         * "start" or "restart" if the local search did not improve the
+         * perturbed, start or restart solution, respectively).
+         *
+         * @param   writer
+         *          The trace writer (nullptr disables the trace). It must
+         *          outlive the calls to solve().
+         * @param   instance
+         *          Name of the instance written in the events.
+         */
+        void set_trace_writer(TraceWriter* writer, const std::string& instance);
+
     private:
 
-        std::tuple<orcs::Schedule, std::tuple<double, double> > perturb(const Problem& problem, const std::tuple<Schedule, std::tuple<double, double> >& entry, std::mt19937& generator);
+        ImprovementCallback improvement_callback_;
+        TraceWriter* trace_writer_ = nullptr;
+        std::string trace_instance_;
+        std::atomic<bool> interrupted_{false};
+
+        std::tuple<orcs::Schedule, std::tuple<double, double> > perturb(const Problem& problem, const std::tuple<Schedule, std::tuple<double, double> >& entry, std::mt19937& generator, EvaluationCache* cache = nullptr);
 
         void log_header(bool verbose = true);
 
@@ -2,8 +2,12 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <functional>
 #include <limits>
+#include <queue>
 #include <random>
+#include <utility>
 
 #include "../../util/common.h"
 
@@ -11,6 +15,14 @@
 std::tuple<orcs::Schedule, double> orcs::NEH::solve(const Problem& problem,
         const cxxproperties::Properties* opt_input, cxxproperties::Properties* opt_output) {
 
+    // Algorithm parameters
+    cxxproperties::Properties opt_aux;
+    if (opt_input == nullptr) {
+        opt_input = &opt_aux;
+    }
+
+    const bool full_evaluation = opt_input->get<bool>("full-evaluation", false);
+
     // Create an empty schedule
     Schedule schedule = create_empty_schedule(problem.m);
 
@@ -29,6 +41,7 @@ std::tuple<orcs::Schedule, double> orcs::NEH::solve(const Problem& problem,
     }
 
     // Assignment and sequencing
+    std::vector<int> candidates;
     while (S_manual.size() + S_remote.size() > 0) {
 
         // Remotely controlled switches
@@ -57,38 +70,20 @@ std::tuple<orcs::Schedule, double> orcs::NEH::solve(const Problem& problem,
         // Manually controlled switches
         if (S_manual.size() > 0) {
 
-            // Choose a switch and a maintenance team
-            double best_objective = std::numeric_limits<double>::infinity();
-            int best_j, best_l, best_idx;
-
-            for (auto j_trial : S_manual) {
-                if (gamma[j_trial] == 0) {
-                    for (int l_trial = 1; l_trial <= problem.m; ++l_trial) {
-                        for (int idx_trial = 0; idx_trial <= schedule[l_trial].size(); ++idx_trial) {
-
-                            schedule[l_trial].insert(schedule[l_trial].begin() + idx_trial, j_trial);
-
-                            std::vector<double> t = problem.start_time(schedule);
-                            double trial_objective = 0.0;
-                            for (const auto& schd : schedule) {
-                                for (auto aux_j : schd) {
-                                    trial_objective = std::max(trial_objective, t[aux_j] + problem.p[aux_j]);
-                                }
-                            }
-
-                            if (common::less(trial_objective, best_objective)) {
-                                best_objective = trial_objective;
-                                best_j = j_trial;
-                                best_l = l_trial;
-                                best_idx = idx_trial;
-                            }
-
-                            schedule[l_trial].erase(schedule[l_trial].begin() + idx_trial);
-                        }
-                    }
+            // Switches whose predecessors are all scheduled
+            candidates.clear();
+            for (auto j : S_manual) {
+                if (gamma[j] == 0) {
+                    candidates.push_back(j);
                 }
             }
 
+            // Choose a switch and a maintenance team
+            int best_j, best_l, best_idx;
+            std::tie(best_j, best_l, best_idx) = full_evaluation ?
+                    best_insertion_full(problem, schedule, candidates) :
+                    best_insertion(problem, schedule, candidates);
+
             // Update the counter of predecessors not scheduled
             for (auto i : problem.successors[best_j]) {
                 --gamma[i];
@@ -105,3 +100,359 @@ std::tuple<orcs::Schedule, double> orcs::NEH::solve(const Problem& problem,
     // Return the solution
     return {schedule, problem.makespan(schedule)};
 }
+
+std::tuple<int, int, int> orcs::NEH::best_insertion(const Problem& problem, const Schedule& schedule,
+        const std::vector<int>& candidates) {
+
+    // Get problem data
+    auto n = problem.n;
+    auto m = problem.m;
+    const auto& p = problem.p;
+
+    // Team and position of each scheduled switch (-1 if not scheduled)
+    std::vector<int> team(n + 1, -1);
+    std::vector<int> index(n + 1, -1);
+    for (int l = 0; l <= m; ++l) {
+        for (int idx = 0; idx < schedule[l].size(); ++idx) {
+            team[schedule[l][idx]] = l;
+            index[schedule[l][idx]] = idx;
+        }
+    }
+
+    // Heads: start times in the topological order used by
+    // Problem::start_time() (a switch waits for its predecessors and for the
+    // switch before it in the sequence of its team, even for team 0)
+    std::vector<double> t(n + 1, 0.0);
+    std::vector<int> pendings(n + 1, 0);
+    std::vector<int> order;
+    std::vector<int> rank(n + 1, -1);
+    order.reserve(n);
+
+    for (int l = 0; l <= m; ++l) {
+        for (int idx = 0; idx < schedule[l].size(); ++idx) {
+            int j = schedule[l][idx];
+            pendings[j] = problem.predecessors[j].size() + (idx > 0 ? 1 : 0);
+            if (pendings[j] == 0) {
+                order.push_back(j);
+            }
+        }
+    }
+
+    auto head = [&](int j, const std::vector<double>& start) -> double {
+        int l = team[j];
+        double h = 0.0;
+        if (l != 0) {
+            int i = (index[j] > 0 ? schedule[l][index[j] - 1] : 0);
+            h = start[i] + p[i] + problem.setup(i, j, l);
+        }
+
+        for (auto k : problem.predecessors[j]) {
+            h = std::max(h, start[k] + p[k]);
+        }
+
+        return h;
+    };
+
+    double makespan = 0.0;
+    for (std::size_t pos = 0; pos < order.size(); ++pos) {
+        int j = order[pos];
+        rank[j] = static_cast<int>(pos);
+        t[j] = head(j, t);
+        makespan = std::max(makespan, t[j] + p[j]);
+
+        for (auto k : problem.successors[j]) {
+            if (team[k] >= 0 && --pendings[k] == 0) {
+                order.push_back(k);
+            }
+        }
+
+        if (index[j] + 1 < schedule[team[j]].size()) {
+            int k = schedule[team[j]][index[j] + 1];
+            if (--pendings[k] == 0) {
+                order.push_back(k);
+            }
+        }
+    }
+
+    // Tails: longest path from the completion of each switch to the end of
+    // the schedule
+    std::vector<double> q(n + 1, 0.0);
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        int i = *it;
+        int l = team[i];
+        if (l != 0 && index[i] + 1 < schedule[l].size()) {
+            int k = schedule[l][index[i] + 1];
+            q[i] = std::max(q[i], problem.setup(i, k, l) + p[k] + q[k]);
+        }
+
+        for (auto k : problem.successors[i]) {
+            if (team[k] >= 0) {
+                q[i] = std::max(q[i], p[k] + q[k]);
+            }
+        }
+    }
+
+    // Transitive closure of the schedule (switches that wait for each
+    // switch), only built if an insertion may close a cycle
+    const std::size_t words = (n + 64) / 64;
+    std::vector<std::uint64_t> closure;
+    auto reaches = [&](int i, int k) -> bool {
+        if (closure.empty()) {
+            closure.assign((n + 1) * words, 0);
+            for (auto it = order.rbegin(); it != order.rend(); ++it) {
+                int v = *it;
+                auto* row = &closure[v * words];
+                row[v / 64] |= std::uint64_t(1) << (v % 64);
+
+                auto merge = [&](int w) {
+                    const auto* other = &closure[w * words];
+                    for (std::size_t word = 0; word < words; ++word) {
+                        row[word] |= other[word];
+                    }
+                };
+
+                if (index[v] + 1 < schedule[team[v]].size()) {
+                    merge(schedule[team[v]][index[v] + 1]);
+                }
+
+                for (auto w : problem.successors[v]) {
+                    if (team[w] >= 0) {
+                        merge(w);
+                    }
+                }
+            }
+        }
+
+        return (closure[i * words + k / 64] >> (k % 64)) & 1;
+    };
+
+    // Makespan of the schedule without the arc into the switch at each
+    // position (computed on demand)
+    std::vector<int> offset(m + 2, 0);
+    for (int l = 1; l <= m; ++l) {
+        offset[l + 1] = offset[l] + static_cast<int>(schedule[l].size());
+    }
+
+    std::vector<double> without_arc(offset[m + 1], -1.0);
+
+    // Switches by decreasing completion time
+    std::vector<int> by_completion(order);
+    std::sort(by_completion.begin(), by_completion.end(), [&t, &p](int i, int j) {
+        return t[i] + p[i] > t[j] + p[j];
+    });
+
+    std::vector<double> start(t);
+    std::vector<char> queued(n + 1, 0);
+    std::vector<int> touched;
+    std::vector<int> modified;
+    std::priority_queue< std::pair<int, int>, std::vector< std::pair<int, int> >,
+            std::greater< std::pair<int, int> > > queue;
+
+    auto makespan_without_arc = [&](int l, int idx) -> double {
+        double& value = without_arc[offset[l] + idx];
+        if (value < 0.0) {
+
+            // Forward propagation of the start times from the switch that
+            // lost the arc, which only waits for its predecessors. Switches
+            // are updated in topological order, and only the successors of
+            // the ones that start earlier are visited.
+            int b = schedule[l][idx];
+            queue.emplace(rank[b], b);
+            queued[b] = 1;
+            touched.push_back(b);
+
+            while (!queue.empty()) {
+                int v = queue.top().second;
+                queue.pop();
+
+                double h = 0.0;
+                if (v == b) {
+                    for (auto k : problem.predecessors[v]) {
+                        h = std::max(h, start[k] + p[k]);
+                    }
+                } else {
+                    h = head(v, start);
+                }
+
+                if (h < start[v]) {
+                    start[v] = h;
+                    modified.push_back(v);
+
+                    auto visit = [&](int w) {
+                        if (!queued[w]) {
+                            queue.emplace(rank[w], w);
+                            queued[w] = 1;
+                            touched.push_back(w);
+                        }
+                    };
+
+                    if (team[v] != 0 && index[v] + 1 < schedule[team[v]].size()) {
+                        visit(schedule[team[v]][index[v] + 1]);
+                    }
+
+                    for (auto w : problem.successors[v]) {
+                        if (team[w] >= 0) {
+                            visit(w);
+                        }
+                    }
+                }
+            }
+
+            // The switches that start earlier finish before the first one
+            // (by completion time) that does not
+            value = 0.0;
+            for (auto v : modified) {
+                value = std::max(value, start[v] + p[v]);
+            }
+
+            for (auto v : by_completion) {
+                if (start[v] == t[v]) {
+                    value = std::max(value, t[v] + p[v]);
+                    break;
+                }
+            }
+
+            // Restore the start times
+            for (auto v : modified) {
+                start[v] = t[v];
+            }
+
+            for (auto v : touched) {
+                queued[v] = 0;
+            }
+
+            modified.clear();
+            touched.clear();
+        }
+
+        return value;
+    };
+
+    // Data of each position (team and index) where a switch can be inserted:
+    // the switch before it (0 if none), the switch after it (-1 if none), the
+    // completion of the former, the processing time plus the tail of the
+    // latter, and whether the arc between them is critical
+    std::vector<int> position_team;
+    std::vector<int> position_before;
+    std::vector<int> position_after;
+    std::vector<double> position_completion;
+    std::vector<double> position_tail;
+    std::vector<char> position_critical;
+
+    for (int l = 1; l <= m; ++l) {
+        for (int idx = 0; idx <= schedule[l].size(); ++idx) {
+            int a = (idx > 0 ? schedule[l][idx - 1] : 0);
+            int b = (idx < schedule[l].size() ? schedule[l][idx] : -1);
+            position_team.push_back(l);
+            position_before.push_back(a);
+            position_after.push_back(b);
+            position_completion.push_back(t[a] + p[a]);
+            position_tail.push_back(b >= 0 ? p[b] + q[b] : 0.0);
+            position_critical.push_back(b >= 0 &&
+                    !common::less(t[a] + p[a] + problem.setup(a, b, l) + p[b] + q[b], makespan));
+        }
+    }
+
+    // Evaluate the insertions (in the same order of the full evaluation)
+    double best_objective = std::numeric_limits<double>::infinity();
+    int best_j = -1, best_l = -1, best_idx = -1;
+
+    for (auto j : candidates) {
+
+        // Earliest completion of the predecessors and the last of them in the
+        // topological order
+        double ready = 0.0;
+        int last = -1;
+        for (auto k : problem.predecessors[j]) {
+            ready = std::max(ready, t[k] + p[k]);
+            last = std::max(last, rank[k]);
+        }
+
+        for (std::size_t pos = 0; pos < position_team.size(); ++pos) {
+
+            // Only insertions on critical arcs can make the schedule shorter
+            // than it is
+            bool critical = position_critical[pos];
+            if (!critical && (makespan >= best_objective || !common::less(makespan, best_objective))) {
+                continue;
+            }
+
+            // Longest path through the switch inserted
+            int l = position_team[pos];
+            int a = position_before[pos];
+            int b = position_after[pos];
+            double objective = std::max(position_completion[pos] + problem.setup(a, j, l), ready) + p[j];
+            if (b >= 0) {
+                objective += std::max(0.0, problem.setup(j, b, l) + position_tail[pos]);
+            }
+
+            if (objective >= best_objective || !common::less(objective, best_objective)) {
+                continue;
+            }
+
+            // Discard the insertion if a predecessor is (or waits for) the
+            // switch after it: the trial schedule has a cycle
+            if (b >= 0 && last >= rank[b]) {
+                bool cycle = false;
+                for (auto k : problem.predecessors[j]) {
+                    cycle = cycle || reaches(b, k);
+                }
+
+                if (cycle) {
+                    continue;
+                }
+            }
+
+            // Longest path that does not use the switch inserted. It only
+            // differs from the makespan if the arc replaced is critical.
+            int idx = static_cast<int>(pos) - offset[l] - (l - 1);
+            if (objective < makespan) {
+                objective = std::max(objective, critical ? makespan_without_arc(l, idx) : makespan);
+            }
+
+            if (common::less(objective, best_objective)) {
+                best_objective = objective;
+                best_j = j;
+                best_l = l;
+                best_idx = idx;
+            }
+        }
+    }
+
+    return {best_j, best_l, best_idx};
+}
+
+std::tuple<int, int, int> orcs::NEH::best_insertion_full(const Problem& problem, Schedule& schedule,
+        const std::vector<int>& candidates) {
+
+    double best_objective = std::numeric_limits<double>::infinity();
+    int best_j = -1, best_l = -1, best_idx = -1;
+
+    for (auto j_trial : candidates) {
+        for (int l_trial = 1; l_trial <= problem.m; ++l_trial) {
+            for (int idx_trial = 0; idx_trial <= schedule[l_trial].size(); ++idx_trial) {
+
+                schedule[l_trial].insert(schedule[l_trial].begin() + idx_trial, j_trial);
+
+                std::vector<double> t = problem.start_time(schedule);
+                double trial_objective = 0.0;
+                for (const auto& schd : schedule) {
+                    for (auto aux_j : schd) {
+                        trial_objective = std::max(trial_objective, t[aux_j] + problem.p[aux_j]);
+                    }
+                }
+
+                if (common::less(trial_objective, best_objective)) {
+                    best_objective = trial_objective;
+                    best_j = j_trial;
+                    best_l = l_trial;
+                    best_idx = idx_trial;
+                }
+
+                schedule[l_trial].erase(schedule[l_trial].begin() + idx_trial);
+            }
+        }
+    }
+
+    return {best_j, best_l, best_idx};
+}
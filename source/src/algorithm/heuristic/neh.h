@@ -1,6 +1,10 @@
 #ifndef MANEUVER_SCHEDULING_NEH_H
 #define MANEUVER_SCHEDULING_NEH_H
 
+#include <set>
+#include <tuple>
+#include <vector>
+
 #include "../algorithm.h"
 
 
@@ -11,6 +15,17 @@ namespace orcs {
      * of electric power distribution networks. This greedy heuristic is based
      * on the insertion criterion of Nawaz, Enscore and Ham's heuristic (NEH)
      * for the flow-show problem.
+     *
+     * The insertions are evaluated in the spirit of Taillard's acceleration:
+     * the start times (heads) and the longest paths from the completions to
+     * the end of the schedule (tails) are computed once per step, and the
+     * makespan of inserting a switch between two others of a team is given
+     * by the longest path through the inserted switch and the longest path
+     * that does not use the arc replaced. The latter is only recomputed (by
+     * a forward propagation of the start times) when the arc replaced is
+     * critical. Insertions that would make a switch wait for itself through
+     * a precedence chain are detected with the transitive closure of the
+     * schedule and discarded, as in a full evaluation.
      */
     class NEH : public Algorithm {
 
@@ -35,6 +50,39 @@ namespace orcs {
                 const cxxproperties::Properties *opt_input = nullptr,
                 cxxproperties::Properties *opt_output = nullptr);
 
+    private:
+
+        /**
+         * Find the best insertion of a switch into a team by evaluating the
+         * makespan of each trial schedule from heads and tails.
+         *
+         * @param   problem
+         *          The instance of the problem.
+         * @param   schedule
+         *          The partial schedule.
+         * @param   candidates
+         *          The switches that can be inserted.
+         * @return  A tuple with the switch, the team and the position.
+         */
+        std::tuple<int, int, int> best_insertion(const Problem& problem, const Schedule& schedule,
+                const std::vector<int>& candidates);
+
+        /**
+         * Find the best insertion of a switch into a team by evaluating each
+         * trial schedule from scratch. It is the reference implementation of
+         * best_insertion().
+         *
+         * @param   problem
+         *          The instance of the problem.
+         * @param   schedule
+         *          The partial schedule.
+         * @param   candidates
+         *          The switches that can be inserted.
+         * @return  A tuple with the switch, the team and the position.
+         */
+        std::tuple<int, int, int> best_insertion_full(const Problem& problem, Schedule& schedule,
+                const std::vector<int>& candidates);
+
     };
 
 }
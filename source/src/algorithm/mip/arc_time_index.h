@@ -0,0 +1,125 @@
+#ifndef MANEUVER_SCHEDULING_ARC_TIME_INDEX_H
+#define MANEUVER_SCHEDULING_ARC_TIME_INDEX_H
+
+#include <cstddef>
+#include <vector>
+
+#include "mip_solver.h"
+
+
+namespace orcs {
+
+    /**
+     * Sparse index of arc- and time-indexed variables. Each arc (i, j, l)
+     * has a window of valid times [first, last], and only the variables of
+     * the valid tuples (i, j, l, r) are stored, contiguously for each arc.
+     */
+    class ArcTimeIndex {
+
+    public:
+
+        /**
+         * Constructor. Create an index in which all windows are empty.
+         *
+         * @param   n
+         *          Number of switches.
+         * @param   m
+         *          Number of teams.
+         */
+        ArcTimeIndex(int n, int m) : n_(n), m_(m), windows_((n + 1) * (n + 1) * (m + 1)) { }
+
+        /**
+         * Set the window of valid times of an arc, reserving a slot for the
+         * variable of each time in the window. The window of an arc can only
+         * be set once.
+         *
+         * @param   i
+         *          The switch the arc leaves.
+         * @param   j
+         *          The switch the arc enters.
+         * @param   l
+         *          The team.
+         * @param   first
+         *          The first valid time.
+         * @param   last
+         *          The last valid time (the window is empty if it is less
+         *          than first).
+         */
+        inline void set_window(int i, int j, int l, int first, int last) {
+            Window& window = windows_[arc(i, j, l)];
+            window.first = first;
+            window.last = last;
+            window.offset = vars_.size();
+            if (last >= first) {
+                vars_.resize(vars_.size() + (last - first + 1));
+            }
+        }
+
+        /**
+         * Return the first valid time of an arc.
+         */
+        inline int first(int i, int j, int l) const {
+            return windows_[arc(i, j, l)].first;
+        }
+
+        /**
+         * Return the last valid time of an arc.
+         */
+        inline int last(int i, int j, int l) const {
+            return windows_[arc(i, j, l)].last;
+        }
+
+        /**
+         * Check if a tuple (i, j, l, r) is valid.
+         *
+         * @return  True if r is in the window of the arc (i, j, l), false
+         *          otherwise.
+         */
+        inline bool contains(int i, int j, int l, int r) const {
+            const Window& window = windows_[arc(i, j, l)];
+            return r >= window.first && r <= window.last;
+        }
+
+        /**
+         * Return the variable of a valid tuple (i, j, l, r).
+         */
+        inline MIPVar& operator()(int i, int j, int l, int r) {
+            const Window& window = windows_[arc(i, j, l)];
+            return vars_[window.offset + (r - window.first)];
+        }
+
+        inline const MIPVar& operator()(int i, int j, int l, int r) const {
+            const Window& window = windows_[arc(i, j, l)];
+            return vars_[window.offset + (r - window.first)];
+        }
+
+        /**
+         * Return the variables of all valid tuples.
+         */
+        inline const std::vector<MIPVar>& vars() const {
+            return vars_;
+        }
+
+    private:
+
+        struct Window {
+            int first = 0;
+            int last = -1;
+            std::size_t offset = 0;
+        };
+
+        int n_;
+        int m_;
+        std::vector<Window> windows_;
+        std::vector<MIPVar> vars_;
+
+        inline std::size_t arc(int i, int j, int l) const {
+            return (static_cast<std::size_t>(i) * (n_ + 1) + j) * (m_ + 1) + l;
+        }
+
+    };
+
+}
+
+
+#endif
@@ -3,11 +3,14 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdlib>
+#include <string>
 
-#include <gurobi_c++.h>
-
-#include "../heuristic/greedy.h"
+#include "arc_time_index.h"
+#include "mip_concurrent_ils.h"
+#include "mip_preprocessing.h"
+#include "mip_solver.h"
 #include "../../util/common.h"
+#include "../../util/time_windows.h"
 
 
 std::tuple<orcs::Schedule, double> orcs::MIPArcTimeIndexed::solve(const Problem& problem,
@@ -20,12 +23,14 @@ std::tuple<orcs::Schedule, double> orcs::MIPArcTimeIndexed::solve(const Problem&
     }
 
     // Solver parameters
-    bool verbose      = opt_input->get<bool>("verbose", false);
-    int threads       = opt_input->get<int>("threads", 0);
-    double time_limit = opt_input->get<double>("time-limit", GRB_INFINITY);
-    double iterations_limit = opt_input->get<double>("iterations-limit", GRB_INFINITY);
     bool warm_start   = opt_input->get<double>("warm-start", false);
     bool solve_lr     = opt_input->get<double>("solve-relaxation", false);
+    auto solver_name  = opt_input->get<std::string>("mip-solver", MIPSolver::available().front());
+    auto initial      = opt_input->get<std::string>("initial-solution", "");
+    bool concurrent   = opt_input->get<bool>("concurrent-ils", false);
+
+    // A solution given by the user is always used as warm start
+    warm_start = warm_start || !initial.empty();
 
     // Variable to keep the solution
     Schedule solution = create_empty_schedule(problem.m);
@@ -46,395 +51,301 @@ std::tuple<orcs::Schedule, double> orcs::MIPArcTimeIndexed::solve(const Problem&
     for (int i = 0; i <= n; ++i) {
         for (int j = 0; j <= n; ++j) {
             for (int l = 1; l <=m; ++l) {
-                s[i][j][l] = static_cast<int>(problem.s[i][j][l] + 0.5);
+                s[i][j][l] = static_cast<int>(problem.setup(i, j, l) + 0.5);
             }
         }
     }
 
-    // Compute the time horizon through a greedy heuristic
-    // Get a heuristic solution
-    auto [schedule, makespan] = Greedy().solve(problem);
-    auto t_ = problem.start_time(schedule);
+    // Compute the time horizon through a heuristic solution
+    auto [schedule, makespan] = preprocessing::heuristic_solution(problem, opt_input);
     int time_horizon = static_cast<int>(makespan + 0.5);
 
-    // Solve the problem with Gurobi solver
-    GRBEnv* env = nullptr;
-
-    try {
-
-        // Gurobi environment and model
-        env = new GRBEnv();
-        GRBModel model(*env);
-
-        // Set some settings of Gurobi solver
-        model.getEnv().set(GRB_IntParam_LogToConsole, (verbose ? 1 : 0));
-        model.getEnv().set(GRB_IntParam_OutputFlag, (verbose ? 1 : 0));
-        model.getEnv().set(GRB_IntParam_Threads, threads);
-        model.getEnv().set(GRB_DoubleParam_TimeLimit, time_limit);
-        model.getEnv().set(GRB_DoubleParam_NodeLimit, iterations_limit);
-
-        // Allocate memory for decision variables
-        GRBVar**** alpha = new GRBVar***[n + 1];
-        for (int i = 0; i <= n; ++i) {
-            alpha[i] = new GRBVar**[n + 1];
-            for (int j = 0; j <= n; ++j) {
-                alpha[i][j] = new GRBVar*[m + 1];
-                for (int l = 1; l <= m; ++l) {
-                    alpha[i][j][l] = new GRBVar[time_horizon];
-                }
-            }
-        }
-
-        GRBVar* t = new GRBVar[n + 1];
+    // Earliest and latest start times of the switches in solutions not worse
+    // than the heuristic one (rounded outwards, as the data are rounded)
+    TimeWindows windows(problem, makespan);
+    auto earliest = std::vector<int>(n + 1, 0);
+    auto latest = std::vector<int>(n + 1, time_horizon);
+    for (int i = 1; i <= n; ++i) {
+        earliest[i] = static_cast<int>(std::floor(windows.earliest(i) + common::THRESHOLD));
+        latest[i] = static_cast<int>(std::ceil(windows.latest(i) - common::THRESHOLD));
+    }
 
-        // Decision variables
-        for (int i = 0; i <= n; ++i) {
-            if (technology[i] != Technology::REMOTE) {
-                for (int j = 1; j <= n; ++j) {
-                    if (j != i && technology[j] != Technology::REMOTE) {
-                        for (int l = 1; l <= m; ++l) {
-                            for (int r = s[0][i][l] + p[i] + s[i][j][l]; r <= time_horizon - p[j]; ++r) {
-                                alpha[i][j][l][r] = model.addVar(0, 1, 0, GRB_BINARY);
-                            }
-                        }
+    // Solve the problem with the MIP solver
+    auto model = MIPSolver::create(solver_name);
+    model->configure(opt_input);
+
+    // Windows of valid start times of the arcs. Only the variables of valid
+    // tuples (i, j, l, r) are created. Preprocessing: (1) switch j starts
+    // within its own time window and after switch i is maneuvered (starting
+    // within its time window) and the team moves to j; and (2) arcs (j, i, l)
+    // whose switch i must precede switch j due to the precedence constraints
+    // are never used, so their windows are left empty.
+    ArcTimeIndex alpha(n, m);
+    for (int i = 0; i <= n; ++i) {
+        if (technology[i] != Technology::REMOTE) {
+            for (int j = 1; j <= n; ++j) {
+                if (j != i && technology[j] != Technology::REMOTE && !(i > 0 && problem.precedence(j, i))) {
+                    for (int l = 1; l <= m; ++l) {
+                        int first = std::max(s[0][i][l], earliest[i]) + p[i] + s[i][j][l];
+                        int last = std::min(time_horizon - p[j], latest[j]);
+                        alpha.set_window(i, j, l, std::max(first, earliest[j]), last);
                     }
                 }
             }
         }
+    }
 
-        for (int i = 1; i <= n; ++i) {
-            t[i] = model.addVar(0, GRB_INFINITY, 0, GRB_CONTINUOUS);
-        }
-
-        GRBVar T = model.addVar(0, GRB_INFINITY, 0, GRB_CONTINUOUS);
-
-        model.update();
-
-        // Warm start
-        if (warm_start) {
+    // Decision variables
+    auto t = std::vector<MIPVar>(n + 1);
 
-            // Initially, make all variables equal zero
-            for (int i = 0; i <= n; ++i) {
-                if (technology[i] != Technology::REMOTE) {
-                    for (int j = 1; j <= n; ++j) {
-                        if (j != i && technology[j] != Technology::REMOTE) {
-                            for (int l = 1; l <= m; ++l) {
-                                for (int r = s[0][i][l] + p[i] + s[i][j][l]; r <= time_horizon - p[j]; ++r) {
-                                    alpha[i][j][l][r].set(GRB_DoubleAttr_Start, 0.0);
-                                }
-                            }
+    for (int i = 0; i <= n; ++i) {
+        if (technology[i] != Technology::REMOTE) {
+            for (int j = 1; j <= n; ++j) {
+                if (j != i && technology[j] != Technology::REMOTE) {
+                    for (int l = 1; l <= m; ++l) {
+                        for (int r = alpha.first(i, j, l); r <= alpha.last(i, j, l); ++r) {
+                            alpha(i, j, l, r) = model->add_var(0, 1, VarType::BINARY);
                         }
                     }
                 }
             }
+        }
+    }
 
-            for (int i = 1; i <= n; ++i) {
-                t[i].set(GRB_DoubleAttr_Start, 0.0);
-            }
-
-            T.set(GRB_DoubleAttr_Start, 0.0);
+    for (int i = 1; i <= n; ++i) {
+        t[i] = model->add_var(0, MIP_INFINITY, VarType::CONTINUOUS);
+    }
 
-            // Set initial value for the variables
-            T.set(GRB_DoubleAttr_Start, makespan);
+    MIPVar T = model->add_var(0, MIP_INFINITY, VarType::CONTINUOUS);
 
-            for (int i = 1; i <= n; ++i) {
-                t[i].set(GRB_DoubleAttr_Start, t_[i]);
-            }
+    // Translate a schedule into values of the variables (with the rounded
+    // data). A schedule cannot be represented if any of its arcs starts out
+    // of the window of the arc.
+    auto translate = [&](const Schedule& candidate, std::vector<MIPVar>& vars, std::vector<double>& values) -> bool {
+        auto t_ = problem.start_time(candidate);
 
-            for (int l = 1; l <= m; ++l) {
-                int i = 0;
-                for (int idx = 0; idx < schedule[l].size(); ++idx) {
-                    int j = schedule[l][idx];
-                    alpha[i][j][l][static_cast<int>(t_[j] + 0.5)].set(GRB_DoubleAttr_Start, 1.0);
-                    i = j;
-                }
-            }
+        // Rounded start times, team and previous switch of each switch
+        std::vector<int> start(n + 1, 0);
+        std::vector<int> team(n + 1, 0);
+        std::vector<int> previous(n + 1, 0);
+        for (int j = 1; j <= n; ++j) {
+            start[j] = static_cast<int>(t_[j] + 0.5);
         }
 
-        // Objective function
-        GRBLinExpr objective = T;
-        model.setObjective(objective, GRB_MINIMIZE);
-
-        // Constraints 1
+        bool valid = true;
         for (int l = 1; l <= m; ++l) {
-            GRBLinExpr expr = 0;
-            for (int j = 1; j <= n; ++j) {
-                if (technology[j] != Technology::REMOTE) {
-                    for (int r = s[0][j][l]; r <= time_horizon - p[j]; ++r) {
-                        expr += alpha[0][j][l][r];
-                    }
-                }
-            }
-            model.addConstr(expr <= 1);
-        }
-
-        // Constraints 2
-        for (int j = 1; j <= n; ++j) {
-            if (technology[j] != Technology::REMOTE) {
-                GRBLinExpr expr = 0;
-                for (int i = 0; i <= n; ++i) {
-                    if (i != j && technology[i] != Technology::REMOTE) {
-                        for (int l = 1; l <= m; ++l) {
-                            for (int r = s[0][i][l] + p[i] + s[i][j][l]; r <= time_horizon - p[j]; ++r) {
-                                expr += alpha[i][j][l][r];
-                            }
-                        }
-                    }
-                }
-                model.addConstr(expr == 1);
+            int i = 0;
+            for (auto j : candidate[l]) {
+                team[j] = l;
+                previous[j] = i;
+                valid = valid && alpha.contains(i, j, l, start[j]);
+                i = j;
             }
         }
 
-        // Constraints 3
-        for (int i = 1; i <= n; ++i) {
+        for (int i = 0; i <= n; ++i) {
             if (technology[i] != Technology::REMOTE) {
-                GRBLinExpr expr = 0;
                 for (int j = 1; j <= n; ++j) {
                     if (j != i && technology[j] != Technology::REMOTE) {
                         for (int l = 1; l <= m; ++l) {
-                            for (int r = s[0][i][l] + p[i] + s[i][j][l]; r <= time_horizon - p[j]; ++r) {
-                                expr += alpha[i][j][l][r];
+                            for (int r = alpha.first(i, j, l); r <= alpha.last(i, j, l); ++r) {
+                                vars.push_back(alpha(i, j, l, r));
+                                values.push_back(previous[j] == i && team[j] == l && start[j] == r ? 1.0 : 0.0);
                             }
                         }
                     }
                 }
-                model.addConstr(expr <= 1);
             }
         }
 
-        // Constraints 4
+        int makespan_ = 0;
         for (int i = 1; i <= n; ++i) {
-            if (technology[i] != Technology::REMOTE) {
-                for (int j = 1; j <= n; ++j) {
-                    if (j != i && technology[j] != Technology::REMOTE) {
-                        for (int l = 1; l <= m; ++l) {
-                            for (int r = s[0][i][l] + p[i] + s[i][j][l]; r <= time_horizon - p[j]; ++r) {
-                                GRBLinExpr expr = 0;
-                                for (int h = 0; h <= n; ++h) {
-                                    if (h != i && h != j && technology[h] != Technology::REMOTE) {
-                                        for (int v = s[0][h][l] + p[h] + s[h][i][l]; v <= r - p[i] - s[i][j][l]; ++v) {
-                                            expr += alpha[h][i][l][v];
-                                        }
-                                    }
-                                }
-                                model.addConstr(alpha[i][j][l][r] <= expr);
-                            }
-                        }
-                    }
-                }
+            vars.push_back(t[i]);
+            values.push_back(start[i]);
+            makespan_ = std::max(makespan_, start[i] + p[i]);
+        }
+
+        vars.push_back(T);
+        values.push_back(makespan_);
+
+        return valid;
+    };
+
+    // Warm start (skipped if the heuristic solution cannot be represented)
+    std::string warm_start_msg = "no";
+    if (warm_start) {
+        std::vector<MIPVar> vars;
+        std::vector<double> values;
+        if (translate(schedule, vars, values)) {
+            for (std::size_t k = 0; k < vars.size(); ++k) {
+                model->set_start(vars[k], values[k]);
             }
+            warm_start_msg = "yes";
+        } else {
+            warm_start_msg = "skipped (the heuristic solution cannot be represented)";
         }
+    }
+
+    // Objective function
+    model->set_objective(T);
 
-        // Constraints 5
+    // Constraints 1
+    for (int l = 1; l <= m; ++l) {
+        LinExpr expr = 0;
         for (int j = 1; j <= n; ++j) {
             if (technology[j] != Technology::REMOTE) {
-                GRBLinExpr expr = 0;
-                for (int i = 0; i <= n; ++i) {
-                    if (i != j && technology[i] != Technology::REMOTE) {
-                        for (int l = 1; l <= m; ++l) {
-                            for (int r = s[0][i][l] + p[i] + s[i][j][l]; r <= time_horizon - p[j]; ++r) {
-                                expr += r * alpha[i][j][l][r];
-                            }
-                        }
-                    }
+                for (int r = alpha.first(0, j, l); r <= alpha.last(0, j, l); ++r) {
+                    expr += alpha(0, j, l, r);
                 }
-                model.addConstr(t[j] == expr);
             }
         }
+        model->add_constr(expr <= 1);
+    }
 
-        // Constraints 6
-        for (int j = 1; j <= n; ++j) {
-            for (auto i : predecessors[j]) {
-                model.addConstr(t[j] >= t[i] + p[i]);
+    // Constraints 2
+    for (int j = 1; j <= n; ++j) {
+        if (technology[j] != Technology::REMOTE) {
+            LinExpr expr = 0;
+            for (int i = 0; i <= n; ++i) {
+                if (i != j && technology[i] != Technology::REMOTE) {
+                    for (int l = 1; l <= m; ++l) {
+                        for (int r = alpha.first(i, j, l); r <= alpha.last(i, j, l); ++r) {
+                            expr += alpha(i, j, l, r);
+                        }
+                    }
+                }
             }
+            model->add_constr(expr == 1);
         }
+    }
 
-        // Constraints 7
-        for (int i = 1; i <= n; ++i) {
-            model.addConstr(T >= t[i] + p[i]);
-        }
-
-        // Preprocessing: fix to zero variables alpha[j][i][l][r] which will
-        // never be equal to one due to the precedence constraints
-        model.update();
-        for (int i = 1; i <= n; ++i) {
-            if (technology[i] != Technology::REMOTE) {
-                for (int j = 1; j <= n; ++j) {
-                    if (j != i && technology[j] != Technology::REMOTE) {
-                        if (problem.precedence[i][j]) {
-                            for (int l = 1; l <= m; ++l) {
-                                for (int r = s[0][j][l] + p[j] + s[j][i][l];
-                                     r <= time_horizon - p[i]; ++r) {
-                                    alpha[j][i][l][r].set(GRB_DoubleAttr_UB, 0);
-                                }
-                            }
+    // Constraints 3
+    for (int i = 1; i <= n; ++i) {
+        if (technology[i] != Technology::REMOTE) {
+            LinExpr expr = 0;
+            for (int j = 1; j <= n; ++j) {
+                if (j != i && technology[j] != Technology::REMOTE) {
+                    for (int l = 1; l <= m; ++l) {
+                        for (int r = alpha.first(i, j, l); r <= alpha.last(i, j, l); ++r) {
+                            expr += alpha(i, j, l, r);
                         }
                     }
                 }
             }
+            model->add_constr(expr <= 1);
         }
+    }
 
-        // Solve the model
-        model.optimize();
-
-        // Get the best solution found (if any)
-        if (model.get(GRB_IntAttr_SolCount) > 0) {
-
+    // Constraints 4
+    for (int i = 1; i <= n; ++i) {
+        if (technology[i] != Technology::REMOTE) {
             for (int j = 1; j <= n; ++j) {
-                if (technology[j] != Technology::REMOTE) {
-                    for (int i = 0; i <= n; ++i) {
-                        if (i != j && technology[i] != Technology::REMOTE)  {
-                            for (int l = 1; l <= m; ++l) {
-                                for (int r = s[0][i][l] + p[i] + s[i][j][l]; r <= time_horizon - p[j]; ++r) {
-                                    if (alpha[i][j][l][r].get(GRB_DoubleAttr_X) > 0.5) {
-                                        solution[l].push_back(j);
+                if (j != i && technology[j] != Technology::REMOTE) {
+                    for (int l = 1; l <= m; ++l) {
+                        for (int r = alpha.first(i, j, l); r <= alpha.last(i, j, l); ++r) {
+                            LinExpr expr = 0;
+                            for (int h = 0; h <= n; ++h) {
+                                if (h != i && h != j && technology[h] != Technology::REMOTE) {
+                                    int last = std::min(alpha.last(h, i, l), r - p[i] - s[i][j][l]);
+                                    for (int v = alpha.first(h, i, l); v <= last; ++v) {
+                                        expr += alpha(h, i, l, v);
                                     }
                                 }
                             }
+                            model->add_constr(alpha(i, j, l, r) <= expr);
                         }
                     }
-                } else {
-                    solution[0].push_back(j);
                 }
             }
-
-            for (int l = 0; l <= m; ++l) {
-                std::sort(solution[l].begin(), solution[l].end(),
-                          [&t](int first, int second) -> bool {
-                              return (t[first].get(GRB_DoubleAttr_X) < t[second].get(GRB_DoubleAttr_X));
-                          });
-            }
         }
+    }
 
-        // Store optional output
-        if (opt_output != nullptr) {
-
-            // Status of the optimization process
-            int status = model.get(GRB_IntAttr_Status);
-            switch (status) {
-
-                case GRB_OPTIMAL:
-                    opt_output->add("Status", "OPTIMAL");
-                    break;
-
-                case GRB_INFEASIBLE:
-                    opt_output->add("Status", "INFEASIBLE");
-                    break;
-
-                case GRB_UNBOUNDED:
-                    opt_output->add("Status", "UNBOUNDED");
-                    break;
-
-                case GRB_INF_OR_UNBD:
-                    opt_output->add("Status", "INF_OR_UNBD");
-                    break;
-
-                default:
-                    if (model.get(GRB_IntAttr_SolCount) > 0) {
-                        opt_output->add("Status", "SUBOPTIMAL");
-                    } else {
-                        opt_output->add("Status", "UNKNOWN");
+    // Constraints 5
+    for (int j = 1; j <= n; ++j) {
+        if (technology[j] != Technology::REMOTE) {
+            LinExpr expr = 0;
+            for (int i = 0; i <= n; ++i) {
+                if (i != j && technology[i] != Technology::REMOTE) {
+                    for (int l = 1; l <= m; ++l) {
+                        for (int r = alpha.first(i, j, l); r <= alpha.last(i, j, l); ++r) {
+                            expr.add_term(alpha(i, j, l, r), r);
+                        }
                     }
+                }
             }
+            model->add_constr(t[j] == expr);
+        }
+    }
 
-            // Objective function of the best solution found (if any)
-            if (model.get(GRB_IntAttr_SolCount) > 0) {
-                opt_output->add("MIP objective", model.get(GRB_DoubleAttr_ObjVal));
-            }
-
-            // Number of iterations (or MIP nodes)
-            try {
-                opt_output->add("Iterations", model.get(GRB_DoubleAttr_NodeCount));
-            } catch (...) {
-                // Do nothing
-            }
+    // Constraints 6
+    for (int j = 1; j <= n; ++j) {
+        for (auto i : predecessors[j]) {
+            model->add_constr(t[j] >= t[i] + p[i]);
+        }
+    }
 
-            // MIP gap
-            try {
-                double mip_gap = model.get(GRB_DoubleAttr_MIPGap);
-                if (common::equal(mip_gap, GRB_INFINITY)) {
-                    opt_output->add("MIP gap", "Infinity");
-                } else {
-                    opt_output->add("MIP gap", mip_gap);
-                }
-            } catch (...) {
-                // Do nothing
-            }
+    // Constraints 7
+    for (int i = 1; i <= n; ++i) {
+        model->add_constr(T >= t[i] + p[i]);
+    }
 
-            // Runtime
-            opt_output->add("MIP runtime (s)", model.get(GRB_DoubleAttr_Runtime));
+    // Run the ILS-based heuristic concurrently and inject its solutions (if
+    // the solver accepts heuristic solutions)
+    concurrent = concurrent && model->supports_heuristic_solutions();
+    ConcurrentILS heuristic(translate);
+    if (concurrent) {
+        model->set_callback(&heuristic);
+        heuristic.start(problem, opt_input);
+    }
 
-            // Solve the linear relaxation
-            if (solve_lr) {
+    // Solve the model
+    model->optimize();
+    heuristic.stop();
 
-                // Reset Gurobi solver
-                model.getEnv().set(GRB_IntParam_OutputFlag, 0);
-                model.getEnv().set(GRB_DoubleParam_TimeLimit, GRB_INFINITY);
-                model.reset();
+    // Get the best solution found (if any)
+    if (model->has_solution()) {
 
-                // Relax the integrality constraints
-                for (int j = 1; j <= n; ++j) {
-                    if (technology[j] != Technology::REMOTE) {
-                        for (int i = 0; i <= n; ++i) {
-                            if (i != j && technology[i] != Technology::REMOTE)  {
-                                for (int l = 1; l <= m; ++l) {
-                                    for (int r = s[0][i][l] + p[i] + s[i][j][l]; r <= time_horizon - p[j]; ++r) {
-                                        alpha[i][j][l][r].set(GRB_CharAttr_VType, GRB_CONTINUOUS);
-                                    }
+        for (int j = 1; j <= n; ++j) {
+            if (technology[j] != Technology::REMOTE) {
+                for (int i = 0; i <= n; ++i) {
+                    if (i != j && technology[i] != Technology::REMOTE)  {
+                        for (int l = 1; l <= m; ++l) {
+                            for (int r = alpha.first(i, j, l); r <= alpha.last(i, j, l); ++r) {
+                                if (model->value(alpha(i, j, l, r)) > 0.5) {
+                                    solution[l].push_back(j);
                                 }
                             }
                         }
                     }
                 }
-
-                // Solve the linear relaxation
-                model.optimize();
-
-                // Value of the objective function
-                if (model.get(GRB_IntAttr_SolCount) > 0) {
-                    opt_output->add("LP objective", model.get(GRB_DoubleAttr_ObjVal));
-                }
-
-                // Runtime
-                opt_output->add("LP runtime (s)", model.get(GRB_DoubleAttr_Runtime));
+            } else {
+                solution[0].push_back(j);
             }
         }
 
-        // Deallocate resources
-        for (int i = 0; i <= n; ++i) {
-            for (int j = 0; j <= n; ++j) {
-                for (int l = 1; l <= m; ++l) {
-                    delete[] alpha[i][j][l];
-                    alpha[i][j][l] = nullptr;
-                }
-                delete[] alpha[i][j];
-                alpha[i][j] = nullptr;
-            }
-            delete[] alpha[i];
-            alpha[i] = nullptr;
+        for (int l = 0; l <= m; ++l) {
+            std::sort(solution[l].begin(), solution[l].end(),
+                      [&model, &t](int first, int second) -> bool {
+                          return (model->value(t[first]) < model->value(t[second]));
+                      });
         }
-        delete[] alpha;
-        alpha = nullptr;
-
-        delete[] t;
-        t = nullptr;
+    }
 
-    } catch (...) {
+    // Store optional output
+    if (opt_output != nullptr) {
+        model->store_mip_output(opt_output);
+        opt_output->add("Time horizon", time_horizon);
+        opt_output->add("Variables", alpha.vars().size());
+        opt_output->add("Warm start", warm_start_msg);
 
-        // Deallocate resources
-        if (env != nullptr) {
-            delete env;
-            env = nullptr;
+        if (concurrent) {
+            opt_output->add("Injected solutions", heuristic.injected());
         }
 
-        // Re-throw the exception
-        throw;
-    }
-
-    // Deallocate resources
-    if (env != nullptr) {
-        delete env;
-        env = nullptr;
+        // Solve the linear relaxation
+        if (solve_lr) {
+            model->solve_relaxation(alpha.vars(), opt_output);
+        }
     }
 
     // Return the solution found
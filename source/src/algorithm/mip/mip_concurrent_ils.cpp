@@ -0,0 +1,90 @@
+#include "mip_concurrent_ils.h"
+
+#include <limits>
+#include <utility>
+
+#include "../../util/common.h"
+
+
+orcs::ConcurrentILS::ConcurrentILS(Translator translator, MIPCallback* next) : translator_(std::move(translator)),
+        next_(next), pending_makespan_(std::numeric_limits<double>::infinity()), has_pending_(false), injected_(0) {
+    // Do nothing
+}
+
+orcs::ConcurrentILS::~ConcurrentILS() {
+    stop();
+}
+
+void orcs::ConcurrentILS::start(const Problem& problem, const cxxproperties::Properties* opt_input) {
+
+    // Algorithm parameters
+    cxxproperties::Properties opt_aux;
+    if (opt_input == nullptr) {
+        opt_input = &opt_aux;
+    }
+
+    cxxproperties::Properties opt_ils;
+    opt_ils.add("seed", opt_input->get<unsigned>("seed", 0));
+    opt_ils.add("time-limit", opt_input->get<double>("time-limit", std::numeric_limits<double>::max()));
+
+    // Keep the best solution found by the ILS until it is injected
+    ils_.set_improvement_callback([this](const Schedule& schedule, const std::tuple<double, double>& evaluation) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (common::less(std::get<0>(evaluation), pending_makespan_)) {
+            pending_ = schedule;
+            pending_makespan_ = std::get<0>(evaluation);
+            has_pending_ = true;
+        }
+    });
+
+    thread_ = std::thread([this, &problem, opt_ils]() {
+        ils_.solve(problem, &opt_ils);
+    });
+}
+
+void orcs::ConcurrentILS::stop() {
+    ils_.interrupt();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void orcs::ConcurrentILS::callback(MIPCallbackContext& context) {
+
+    // Call the other callback first
+    if (next_ != nullptr) {
+        next_->callback(context);
+    }
+
+    if (context.where() != MIPCallbackContext::Where::NODE) {
+        return;
+    }
+
+    // Take the pending solution (if any)
+    Schedule schedule;
+    double makespan;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!has_pending_) {
+            return;
+        }
+
+        schedule = std::move(pending_);
+        makespan = pending_makespan_;
+        has_pending_ = false;
+    }
+
+    // Inject it if it improves the incumbent of the solver
+    if (common::less(makespan, context.best_objective())) {
+        std::vector<MIPVar> vars;
+        std::vector<double> values;
+        if (translator_(schedule, vars, values)) {
+            context.set_solution(vars, values);
+            ++injected_;
+        }
+    }
+}
+
+long orcs::ConcurrentILS::injected() const {
+    return injected_;
+}
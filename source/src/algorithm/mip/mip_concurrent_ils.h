@@ -0,0 +1,97 @@
+#ifndef MANEUVER_SCHEDULING_MIP_CONCURRENT_ILS_H
+#define MANEUVER_SCHEDULING_MIP_CONCURRENT_ILS_H
+
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <cxxproperties.hpp>
+
+#include "mip_solver.h"
+#include "../heuristic/ils.h"
+#include "../../problem/problem.h"
+
+
+namespace orcs {
+
+    /**
+     * MIP callback that runs the ILS-based heuristic in a background thread
+     * while the MIP solver runs, and injects the improved solutions found by
+     * the ILS as heuristic solutions at the nodes of the branch-and-bound
+     * tree. Only the best pending solution is injected, and only if it is
+     * better than the incumbent of the solver.
+     */
+    class ConcurrentILS : public MIPCallback {
+
+    public:
+
+        /**
+         * Function that translates a schedule into values of the variables of
+         * a formulation. It returns false if the schedule cannot be
+         * represented by the formulation.
+         */
+        using Translator = std::function<bool(const Schedule&, std::vector<MIPVar>&, std::vector<double>&)>;
+
+        /**
+         * Constructor.
+         *
+         * @param   translator
+         *          The function that translates schedules into values of the
+         *          variables of the formulation.
+         * @param   next
+         *          Another callback called before the injection (e.g., to add
+         *          lazy constraints). It can be set to nullptr.
+         */
+        ConcurrentILS(Translator translator, MIPCallback* next = nullptr);
+
+        /**
+         * Destructor. Stop the ILS if it is still running.
+         */
+        ~ConcurrentILS() override;
+
+        /**
+         * Start the ILS in a background thread.
+         *
+         * @param   problem
+         *          The instance of the problem (it must outlive the ILS).
+         * @param   opt_input
+         *          Input arguments of the MIP solver. The seed and the time
+         *          limit are also used by the ILS. It can be set to nullptr.
+         */
+        void start(const Problem& problem, const cxxproperties::Properties* opt_input);
+
+        /**
+         * Stop the ILS and wait for its thread to finish.
+         */
+        void stop();
+
+        void callback(MIPCallbackContext& context) override;
+
+        /**
+         * Return the number of solutions injected into the MIP solver.
+         */
+        long injected() const;
+
+    private:
+
+        Translator translator_;
+        MIPCallback* next_;
+
+        ILS ils_;
+        std::thread thread_;
+
+        // Best solution found by the ILS not injected yet
+        std::mutex mutex_;
+        Schedule pending_;
+        double pending_makespan_;
+        bool has_pending_;
+
+        long injected_;
+
+    };
+
+}
+
+
+#endif
@@ -3,13 +3,110 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdlib>
+#include <tuple>
+#include <vector>
 
-#include <gurobi_c++.h>
-
+#include "mip_concurrent_ils.h"
+#include "mip_solver.h"
 #include "../heuristic/greedy.h"
 #include "../../util/common.h"
 
 
+namespace {
+
+    /*
+     * Separation of the transitivity constraints (Constraints 4) of the
+     * linear ordering formulation. A violated constraint corresponds to a
+     * cycle i -> k -> j -> i among the ordering variables. Each cycle is
+     * enumerated once, starting from its switch of smallest index.
+     */
+    class TriangleSeparator : public orcs::MIPCallback {
+
+    public:
+
+        TriangleSeparator(const std::vector<int>& manual, const std::vector< std::vector<orcs::MIPVar> >& z) :
+                manual_(manual), z_(z), n_(z.size() - 1), added_(0) {
+            // Do nothing
+        }
+
+        void callback(orcs::MIPCallbackContext& context) override {
+
+            // Values of the ordering variables
+            std::vector<double> value((n_ + 1) * (n_ + 1), 0.0);
+            for (auto i : manual_) {
+                for (auto j : manual_) {
+                    if (j != i) {
+                        value[i * (n_ + 1) + j] = context.value(z_[i][j]);
+                    }
+                }
+            }
+
+            // Find the violated constraints
+            std::vector< std::tuple<double, int, int, int> > violated;
+            for (auto i : manual_) {
+                for (auto j : manual_) {
+                    if (j > i) {
+                        for (auto k : manual_) {
+                            if (k > i && k != j) {
+                                double lhs = value[i * (n_ + 1) + k] + value[k * (n_ + 1) + j] + value[j * (n_ + 1) + i];
+                                if (lhs > 2.0 + TOLERANCE) {
+                                    violated.emplace_back(lhs - 2.0, i, j, k);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            if (context.where() == orcs::MIPCallbackContext::Where::SOLUTION) {
+
+                // Cut off the incumbent with all violated constraints
+                for (const auto& [violation, i, j, k] : violated) {
+                    context.add_lazy(z_[i][k] + z_[k][j] + z_[j][i] <= 2);
+                }
+
+            } else {
+
+                // Add only the most violated constraints as cuts, to keep the
+                // node relaxations small
+                std::size_t max_cuts = manual_.size();
+                if (violated.size() > max_cuts) {
+                    std::partial_sort(violated.begin(), violated.begin() + max_cuts, violated.end(),
+                            [](const auto& first, const auto& second) -> bool {
+                                return std::get<0>(first) > std::get<0>(second);
+                            });
+                    violated.resize(max_cuts);
+                }
+
+                for (const auto& [violation, i, j, k] : violated) {
+                    context.add_cut(z_[i][k] + z_[k][j] + z_[j][i] <= 2);
+                }
+            }
+
+            added_ += violated.size();
+        }
+
+        /*
+         * Number of constraints added by the callback.
+         */
+        long added() const {
+            return added_;
+        }
+
+    private:
+
+        static constexpr double TOLERANCE = 1e-4;
+
+        const std::vector<int>& manual_;
+        const std::vector< std::vector<orcs::MIPVar> >& z_;
+        int n_;
+        long added_;
+
+    };
+
+}
+
+
 std::tuple<orcs::Schedule, double> orcs::MIPLinearOrdering::solve(const Problem& problem,
         const cxxproperties::Properties* opt_input, cxxproperties::Properties* opt_output) {
 
@@ -20,12 +117,15 @@ std::tuple<orcs::Schedule, double> orcs::MIPLinearOrdering::solve(const Problem&
     }
 
     // Solver parameters
-    bool verbose      = opt_input->get<bool>("verbose", false);
-    int threads       = opt_input->get<int>("threads", 0);
-    double time_limit = opt_input->get<double>("time-limit", GRB_INFINITY);
-    double iterations_limit = opt_input->get<double>("iterations-limit", GRB_INFINITY);
     bool warm_start   = opt_input->get<double>("warm-start", false);
     bool solve_lr     = opt_input->get<double>("solve-relaxation", false);
+    auto solver_name  = opt_input->get<std::string>("mip-solver", MIPSolver::available().front());
+    auto initial      = opt_input->get<std::string>("initial-solution", "");
+    bool lazy         = opt_input->get<bool>("lazy-triangles", false);
+    bool concurrent   = opt_input->get<bool>("concurrent-ils", false);
+
+    // A solution given by the user is always used as warm start
+    warm_start = warm_start || !initial.empty();
 
     // Variable to keep the solution
     Schedule solution = create_empty_schedule(problem.m);
@@ -33,7 +133,6 @@ std::tuple<orcs::Schedule, double> orcs::MIPLinearOrdering::solve(const Problem&
     // Get problem data
     auto n = problem.n;
     auto m = problem.m;
-    const auto& s = problem.s;
     const auto& p = problem.p;
     const auto& technology = problem.technology;
     const auto& predecessors = problem.predecessors;
@@ -46,7 +145,7 @@ std::tuple<orcs::Schedule, double> orcs::MIPLinearOrdering::solve(const Problem&
             for (int i = 0; i <= n; ++i) {
                 if (i != j && technology[i] != Technology::REMOTE) {
                     for (int l = 1; l <= m; ++l) {
-                        max_c = std::max(max_c, s[i][j][l]);
+                        max_c = std::max(max_c, problem.setup(i, j, l));
                     }
                 }
             }
@@ -54,374 +153,278 @@ std::tuple<orcs::Schedule, double> orcs::MIPLinearOrdering::solve(const Problem&
         M += max_c + p[j];
     }
 
-    // Solve the problem with Gurobi solver
-    GRBEnv* env = nullptr;
+    // Solve the problem with the MIP solver
+    auto model = MIPSolver::create(solver_name);
+    model->configure(opt_input);
+
+    // The transitivity constraints can only be added lazily if the solver
+    // supports lazy constraints
+    lazy = lazy && model->supports_lazy_constraints();
 
-    try {
+    // Manual switches
+    std::vector<int> manual;
+    for (int i = 1; i <= n; ++i) {
+        if (technology[i] != Technology::REMOTE) {
+            manual.push_back(i);
+        }
+    }
 
-        // Gurobi environment and model
-        env = new GRBEnv();
-        GRBModel model(*env);
+    // Decision variables
+    auto y = std::vector< std::vector<MIPVar> >(n + 1, std::vector<MIPVar>(m + 1));
+    auto z = std::vector< std::vector<MIPVar> >(n + 1, std::vector<MIPVar>(n + 1));
+    auto t = std::vector<MIPVar>(n + 1);
+    std::vector<MIPVar> binaries;
 
-        // Set some settings of Gurobi solver
-        model.getEnv().set(GRB_IntParam_LogToConsole, (verbose ? 1 : 0));
-        model.getEnv().set(GRB_IntParam_OutputFlag, (verbose ? 1 : 0));
-        model.getEnv().set(GRB_IntParam_Threads, threads);
-        model.getEnv().set(GRB_DoubleParam_TimeLimit, time_limit);
-        model.getEnv().set(GRB_DoubleParam_NodeLimit, iterations_limit);
+    for (int i = 1; i <= n; ++i) {
+        if (technology[i] != Technology::REMOTE) {
 
-        // Allocate memory for decision variables
-        GRBVar** y = new GRBVar*[n + 1];
-        for (int i = 0; i <= n; ++i) {
-            y[i] = new GRBVar[m + 1];
-        }
+            // Assignment variables
+            for (int l = 1; l <= m; ++l) {
+                y[i][l] = model->add_var(0, 1, VarType::BINARY);
+                binaries.push_back(y[i][l]);
+            }
 
-        GRBVar** z = new GRBVar*[n + 1];
-        for (int i = 0; i <= n; ++i) {
-            z[i] = new GRBVar[n + 1];
+            // Ordering variables
+            for (int j = 1; j <= n; ++j) {
+                if (j != i && technology[j] != Technology::REMOTE) {
+                    z[i][j] = model->add_var(0, 1, VarType::BINARY);
+                    binaries.push_back(z[i][j]);
+                }
+            }
         }
+    }
+
+    for (int i = 1; i <= n; ++i) {
+        t[i] = model->add_var(0, MIP_INFINITY, VarType::CONTINUOUS);
+    }
 
-        GRBVar* t = new GRBVar[n + 1];
+    MIPVar T = model->add_var(0, MIP_INFINITY, VarType::CONTINUOUS);
+
+    // Translate a schedule into values of the variables
+    auto translate = [&](const Schedule& candidate, std::vector<MIPVar>& vars, std::vector<double>& values) -> bool {
+        auto t_ = problem.start_time(candidate);
+
+        // Team and position of each manual switch
+        std::vector<int> team(n + 1, 0);
+        std::vector<int> position(n + 1, 0);
+        for (int l = 1; l <= m; ++l) {
+            for (int idx = 0; idx < candidate[l].size(); ++idx) {
+                team[candidate[l][idx]] = l;
+                position[candidate[l][idx]] = idx;
+            }
+        }
 
-        // Decision variables
         for (int i = 1; i <= n; ++i) {
             if (technology[i] != Technology::REMOTE) {
-
-                // Assignment variables
                 for (int l = 1; l <= m; ++l) {
-                    y[i][l] = model.addVar(0, 1, 0, GRB_BINARY);
+                    vars.push_back(y[i][l]);
+                    values.push_back(team[i] == l ? 1.0 : 0.0);
                 }
 
-                // Ordering variables
                 for (int j = 1; j <= n; ++j) {
                     if (j != i && technology[j] != Technology::REMOTE) {
-                        z[i][j] = model.addVar(0, 1, 0, GRB_BINARY);
+                        vars.push_back(z[i][j]);
+                        values.push_back(team[i] == team[j] && position[i] < position[j] ? 1.0 : 0.0);
                     }
                 }
             }
         }
 
         for (int i = 1; i <= n; ++i) {
-            t[i] = model.addVar(0, GRB_INFINITY, 0, GRB_CONTINUOUS);
+            vars.push_back(t[i]);
+            values.push_back(t_[i]);
         }
 
-        GRBVar T = model.addVar(0, GRB_INFINITY, 0, GRB_CONTINUOUS);
-
-        model.update();
-
-        // Warm start
-        if (warm_start) {
+        vars.push_back(T);
+        values.push_back(problem.makespan(candidate));
 
-            // Initially, make all variables equal zero
-            for (int i = 1; i <= n; ++i) {
-                if (technology[i] != Technology::REMOTE) {
+        return true;
+    };
 
-                    for (int l = 1; l <= m; ++l) {
-                        y[i][l].set(GRB_DoubleAttr_Start, 0.0);
-                    }
+    // Warm start
+    if (warm_start) {
+        Schedule schedule = initial.empty() ? std::get<0>(Greedy().solve(problem)) :
+                common::read_solution(initial, problem);
 
-                    for (int j = 1; j <= n; ++j) {
-                        if (j != i && technology[j] != Technology::REMOTE) {
-                            z[i][j].set(GRB_DoubleAttr_Start, 0.0);
-                        }
-                    }
-                }
-            }
-
-            for (int i = 1; i <= n; ++i) {
-                t[i].set(GRB_DoubleAttr_Start, 0.0);
-            }
-
-            T.set(GRB_DoubleAttr_Start, 0.0);
-
-            // Get a heuristic solution
-            auto [schedule, makespan] = Greedy().solve(problem);
-            auto t_ = problem.start_time(schedule);
-
-            // Set initial value for the variables
-            T.set(GRB_DoubleAttr_Start, makespan);
-
-            for (int i = 1; i <= n; ++i) {
-                t[i].set(GRB_DoubleAttr_Start, t_[i]);
-            }
-
-            for (int l = 1; l <= m; ++l) {
-                if (schedule[l].size() > 0) {
-                    for (int idx = 0; idx < schedule[l].size(); ++idx) {
-                        int i = schedule[l][idx];
-                        y[i][l].set(GRB_DoubleAttr_Start, 1.0);
-                        for (int idx_next = idx + 1; idx_next < schedule[l].size(); ++idx_next) {
-                            int j = schedule[l][idx_next];
-                            z[i][j].set(GRB_DoubleAttr_Start, 1.0);
-                        }
-                    }
-                }
-            }
+        std::vector<MIPVar> vars;
+        std::vector<double> values;
+        translate(schedule, vars, values);
+        for (std::size_t k = 0; k < vars.size(); ++k) {
+            model->set_start(vars[k], values[k]);
         }
+    }
 
-        // Objective function
-        GRBLinExpr objective = T;
-        model.setObjective(objective, GRB_MINIMIZE);
-
-        // Constraints 1
-        for (int i = 1; i <= n; ++i) {
-            if (technology[i] != Technology::REMOTE) {
-                GRBLinExpr expr = 0;
-                for (int l = 1; l <= m; ++l) {
-                    expr += y[i][l];
-                }
-                model.addConstr(expr == 1);
-            }
-        }
+    // Objective function
+    model->set_objective(T);
 
-        // Constraints 2
-        for (int l = 1; l <= m; ++l) {
-            for (int i = 1; i <= n; ++i) {
-                if (technology[i] != Technology::REMOTE) {
-                    for (int j = i + 1; j <= n; ++j) {
-                        if (j != i && technology[j] != Technology::REMOTE) {
-                            model.addConstr(z[i][j] + z[j][i] >= y[i][l] + y[j][l] - 1);
-                        }
-                    }
-                }
+    // Constraints 1
+    for (int i = 1; i <= n; ++i) {
+        if (technology[i] != Technology::REMOTE) {
+            LinExpr expr = 0;
+            for (int l = 1; l <= m; ++l) {
+                expr += y[i][l];
             }
+            model->add_constr(expr == 1);
         }
+    }
 
-        // Constraints 3
+    // Constraints 2
+    for (int l = 1; l <= m; ++l) {
         for (int i = 1; i <= n; ++i) {
             if (technology[i] != Technology::REMOTE) {
                 for (int j = i + 1; j <= n; ++j) {
                     if (j != i && technology[j] != Technology::REMOTE) {
-                        model.addConstr(z[i][j] + z[j][i] <= 1);
-                    }
-                }
-            }
-        }
-
-        // Constraints 4
-        for (int i = 1; i <= n; ++i) {
-            if (technology[i] != Technology::REMOTE) {
-                for (int j = 1; j <= n; ++j) {
-                    if (j != i && technology[j] != Technology::REMOTE) {
-                        for (int k = 1; k <= n; ++k) {
-                            if (k != i && k != j && technology[k] != Technology::REMOTE) {
-                                model.addConstr(z[i][k] + z[k][j] + z[j][i] <= 2);
-                            }
-                        }
+                        model->add_constr(z[i][j] + z[j][i] >= y[i][l] + y[j][l] - 1);
                     }
                 }
             }
         }
+    }
 
-        // Constraints 5
-        for (int i = 1; i <= n; ++i) {
-            if (technology[i] != Technology::REMOTE) {
-                GRBLinExpr expr = 0;
-                for (int l = 1; l <= m; ++l) {
-                    expr += s[0][i][l] * y[i][l];
+    // Constraints 3
+    for (int i = 1; i <= n; ++i) {
+        if (technology[i] != Technology::REMOTE) {
+            for (int j = i + 1; j <= n; ++j) {
+                if (j != i && technology[j] != Technology::REMOTE) {
+                    model->add_constr(z[i][j] + z[j][i] <= 1);
                 }
-                model.addConstr(t[i] >= expr);
             }
         }
+    }
 
-        // Constraints 6
-        for (int i = 1; i <= n; ++i) {
-            if (technology[i] != Technology::REMOTE) {
-                for (int j = 1; j <= n; ++j) {
-                    if (j != i && technology[j] != Technology::REMOTE) {
-                        GRBLinExpr expr = 0;
-                        for (int l = 1; l <= m; ++l) {
-                            expr += s[i][j][l] * y[j][l];
+    // Constraints 4 (if they are not added lazily by the callback)
+    auto add_triangles = [&model, &manual, &z]() {
+        for (auto i : manual) {
+            for (auto j : manual) {
+                if (j != i) {
+                    for (auto k : manual) {
+                        if (k != i && k != j) {
+                            model->add_constr(z[i][k] + z[k][j] + z[j][i] <= 2);
                         }
-                        model.addConstr(t[j] >= t[i] + p[i] + expr - M * (1 - z[i][j]));
                     }
                 }
             }
         }
+    };
 
-        // Constraints 7
-        for (int j = 1; j <= n; ++j) {
-            for (auto i : predecessors[j]) {
-                model.addConstr(t[j] >= t[i] + p[i]);
-            }
-        }
+    TriangleSeparator separator(manual, z);
+    if (!lazy) {
+        add_triangles();
+    }
 
-        // Constraints 8
-        for (int i = 1; i <= n; ++i) {
-            model.addConstr(T >= t[i] + p[i]);
-        }
+    // Callbacks: the separation of the transitivity constraints, and the
+    // injection of the solutions of the ILS-based heuristic run concurrently
+    // (if the solver accepts heuristic solutions)
+    concurrent = concurrent && model->supports_heuristic_solutions();
+    ConcurrentILS heuristic(translate, lazy ? &separator : nullptr);
+    if (concurrent) {
+        model->set_callback(&heuristic, lazy);
+    } else if (lazy) {
+        model->set_callback(&separator, true);
+    }
 
-        // Preprocessing: fix to zero variables z[j][i] which will never be
-        // equal to one due to the precedence constraints
-        model.update();
-        for (int i = 1; i <= n; ++i) {
-            if (technology[i] != Technology::REMOTE) {
-                for (int j = 1; j <= n; ++j) {
-                    if (j != i && technology[j] != Technology::REMOTE) {
-                        if (problem.precedence[i][j]) {
-                            z[j][i].set(GRB_DoubleAttr_UB, 0);
-                        }
-                    }
-                }
+    // Constraints 5
+    for (int i = 1; i <= n; ++i) {
+        if (technology[i] != Technology::REMOTE) {
+            LinExpr expr = 0;
+            for (int l = 1; l <= m; ++l) {
+                expr += problem.setup(0, i, l) * y[i][l];
             }
+            model->add_constr(t[i] >= expr);
         }
+    }
 
-        // Solve the model
-        model.optimize();
-
-        // Get the best solution found (if any)
-        if (model.get(GRB_IntAttr_SolCount) > 0) {
-
+    // Constraints 6
+    for (int i = 1; i <= n; ++i) {
+        if (technology[i] != Technology::REMOTE) {
             for (int j = 1; j <= n; ++j) {
-                if (technology[j] != Technology::REMOTE) {
+                if (j != i && technology[j] != Technology::REMOTE) {
+                    LinExpr expr = 0;
                     for (int l = 1; l <= m; ++l) {
-                        if (y[j][l].get(GRB_DoubleAttr_X) > 0.5) {
-                            solution[l].push_back(j);
-                        }
+                        expr += problem.setup(i, j, l) * y[j][l];
                     }
-                } else {
-                    solution[0].push_back(j);
+                    model->add_constr(t[j] >= t[i] + p[i] + expr - M * (1 - z[i][j]));
                 }
             }
-
-            for (int l = 0; l <= m; ++l) {
-                std::sort(solution[l].begin(), solution[l].end(),
-                        [&t](int first, int second) -> bool {
-                            return (t[first].get(GRB_DoubleAttr_X) < t[second].get(GRB_DoubleAttr_X));
-                        });
-            }
         }
+    }
 
-        // Store optional output
-        if (opt_output != nullptr) {
-
-            // Status of the optimization process
-            int status = model.get(GRB_IntAttr_Status);
-            switch (status) {
-
-                case GRB_OPTIMAL:
-                    opt_output->add("Status", "OPTIMAL");
-                    break;
-
-                case GRB_INFEASIBLE:
-                    opt_output->add("Status", "INFEASIBLE");
-                    break;
-
-                case GRB_UNBOUNDED:
-                    opt_output->add("Status", "UNBOUNDED");
-                    break;
+    // Constraints 7
+    for (int j = 1; j <= n; ++j) {
+        for (auto i : predecessors[j]) {
+            model->add_constr(t[j] >= t[i] + p[i]);
+        }
+    }
 
-                case GRB_INF_OR_UNBD:
-                    opt_output->add("Status", "INF_OR_UNBD");
-                    break;
+    // Constraints 8
+    for (int i = 1; i <= n; ++i) {
+        model->add_constr(T >= t[i] + p[i]);
+    }
 
-                default:
-                    if (model.get(GRB_IntAttr_SolCount) > 0) {
-                        opt_output->add("Status", "SUBOPTIMAL");
-                    } else {
-                        opt_output->add("Status", "UNKNOWN");
+    // Preprocessing: fix to zero variables z[j][i] which will never be
+    // equal to one due to the precedence constraints
+    for (int i = 1; i <= n; ++i) {
+        if (technology[i] != Technology::REMOTE) {
+            for (int j = 1; j <= n; ++j) {
+                if (j != i && technology[j] != Technology::REMOTE) {
+                    if (problem.precedence(i, j)) {
+                        model->set_upper_bound(z[j][i], 0);
                     }
-            }
-
-            // Objective function of the best solution found (if any)
-            if (model.get(GRB_IntAttr_SolCount) > 0) {
-                opt_output->add("MIP objective", model.get(GRB_DoubleAttr_ObjVal));
-            }
-
-            // Number of iterations (or MIP nodes)
-            try {
-                opt_output->add("Iterations", model.get(GRB_DoubleAttr_NodeCount));
-            } catch (...) {
-                // Do nothing
-            }
-
-            // MIP gap
-            try {
-                double mip_gap = model.get(GRB_DoubleAttr_MIPGap);
-                if (common::equal(mip_gap, GRB_INFINITY)) {
-                    opt_output->add("MIP gap", "Infinity");
-                } else {
-                    opt_output->add("MIP gap", mip_gap);
                 }
-            } catch (...) {
-                // Do nothing
             }
+        }
+    }
 
-            // Runtime
-            opt_output->add("MIP runtime (s)", model.get(GRB_DoubleAttr_Runtime));
-
-            // Solve the linear relaxation
-            if (solve_lr) {
-
-                // Reset Gurobi solver
-                model.getEnv().set(GRB_IntParam_OutputFlag, 0);
-                model.getEnv().set(GRB_DoubleParam_TimeLimit, GRB_INFINITY);
-                model.reset();
+    // Solve the model
+    if (concurrent) {
+        heuristic.start(problem, opt_input);
+    }
 
-                // Relax the integrality constraints
-                for (int i = 1; i <= n; ++i) {
-                    if (technology[i] != Technology::REMOTE) {
+    model->optimize();
+    heuristic.stop();
 
-                        for (int l = 1; l <= m; ++l) {
-                            y[i][l].set(GRB_CharAttr_VType, GRB_CONTINUOUS);
-                        }
+    // Get the best solution found (if any)
+    if (model->has_solution()) {
 
-                        for (int j = 1; j <= n; ++j) {
-                            if (j != i && technology[j] != Technology::REMOTE) {
-                                z[i][j].set(GRB_CharAttr_VType, GRB_CONTINUOUS);
-                            }
-                        }
+        for (int j = 1; j <= n; ++j) {
+            if (technology[j] != Technology::REMOTE) {
+                for (int l = 1; l <= m; ++l) {
+                    if (model->value(y[j][l]) > 0.5) {
+                        solution[l].push_back(j);
                     }
                 }
-
-                // Solve the linear relaxation
-                model.optimize();
-
-                // Value of the objective function
-                if (model.get(GRB_IntAttr_SolCount) > 0) {
-                    opt_output->add("LP objective", model.get(GRB_DoubleAttr_ObjVal));
-                }
-
-                // Runtime
-                opt_output->add("LP runtime (s)", model.get(GRB_DoubleAttr_Runtime));
+            } else {
+                solution[0].push_back(j);
             }
         }
 
-        // Deallocate resources
-        for (int i = 0; i <= n; ++i) {
-
-            delete[] y[i];
-            y[i] = nullptr;
-
-            delete[] z[i];
-            z[i] = nullptr;
+        for (int l = 0; l <= m; ++l) {
+            std::sort(solution[l].begin(), solution[l].end(),
+                    [&model, &t](int first, int second) -> bool {
+                        return (model->value(t[first]) < model->value(t[second]));
+                    });
         }
+    }
 
-        delete[] y;
-        y = nullptr;
-
-        delete[] z;
-        z = nullptr;
-
-        delete[] t;
-        t = nullptr;
-
-    } catch (...) {
+    // Store optional output
+    if (opt_output != nullptr) {
+        model->store_mip_output(opt_output);
 
-        // Deallocate resources
-        if (env != nullptr) {
-            delete env;
-            env = nullptr;
+        if (lazy) {
+            opt_output->add("Lazy constraints", separator.added());
         }
 
-        // Re-throw the exception
-        throw;
-    }
+        if (concurrent) {
+            opt_output->add("Injected solutions", heuristic.injected());
+        }
 
-    // Deallocate resources
-    if (env != nullptr) {
-        delete env;
-        env = nullptr;
+        // Solve the linear relaxation (of the complete formulation)
+        if (solve_lr) {
+            if (lazy) {
+                add_triangles();
+            }
+            model->solve_relaxation(binaries, opt_output);
+        }
     }
 
     // Return the solution found
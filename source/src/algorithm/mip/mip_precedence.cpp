@@ -3,11 +3,13 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdlib>
+#include <string>
 
-#include <gurobi_c++.h>
-
-#include "../heuristic/greedy.h"
+#include "mip_concurrent_ils.h"
+#include "mip_preprocessing.h"
+#include "mip_solver.h"
 #include "../../util/common.h"
+#include "../../util/time_windows.h"
 
 
 std::tuple<orcs::Schedule, double> orcs::MIPPrecedence::solve(const Problem& problem,
@@ -20,12 +22,14 @@ std::tuple<orcs::Schedule, double> orcs::MIPPrecedence::solve(const Problem& pro
     }
 
     // Solver parameters
-    bool verbose      = opt_input->get<bool>("verbose", false);
-    int threads       = opt_input->get<int>("threads", 0);
-    double time_limit = opt_input->get<double>("time-limit", GRB_INFINITY);
-    double iterations_limit = opt_input->get<double>("iterations-limit", GRB_INFINITY);
     bool warm_start   = opt_input->get<double>("warm-start", false);
     bool solve_lr     = opt_input->get<double>("solve-relaxation", false);
+    auto solver_name  = opt_input->get<std::string>("mip-solver", MIPSolver::available().front());
+    auto initial      = opt_input->get<std::string>("initial-solution", "");
+    bool concurrent   = opt_input->get<bool>("concurrent-ils", false);
+
+    // A solution given by the user is always used as warm start
+    warm_start = warm_start || !initial.empty();
 
     // Variable to keep the solution
     Schedule solution = create_empty_schedule(problem.m);
@@ -33,61 +37,92 @@ std::tuple<orcs::Schedule, double> orcs::MIPPrecedence::solve(const Problem& pro
     // Get problem data
     auto n = problem.n;
     auto m = problem.m;
-    const auto& s = problem.s;
     const auto& p = problem.p;
     const auto& technology = problem.technology;
     const auto& predecessors = problem.predecessors;
 
-    // Compute the big-M value
-    double M = 0.0;
-    for (int j = 1; j <= n; ++j) {
-        double max_c = 0.0;
-        if (technology[j] != Technology::REMOTE) {
-            for (int i = 0; i <= n; ++i) {
-                if (i != j && technology[i] != Technology::REMOTE) {
+    // Bound the makespan through a heuristic solution (its makespan is the
+    // one of the schedule, so that the windows and big-M values below are
+    // valid for the optimal solutions)
+    auto [schedule, makespan] = preprocessing::heuristic_solution(problem, opt_input);
+
+    // Earliest and latest start times of the switches in solutions not worse
+    // than the heuristic one (widened by a small tolerance)
+    TimeWindows windows(problem, makespan);
+    auto earliest = std::vector<double>(n + 1, 0.0);
+    auto latest = std::vector<double>(n + 1, 0.0);
+    for (int i = 1; i <= n; ++i) {
+        earliest[i] = std::max(0.0, windows.earliest(i) - common::THRESHOLD);
+        latest[i] = windows.latest(i) + common::THRESHOLD;
+    }
+
+    // Compute the big-M value of each arc: if the arc is not used, the
+    // sequencing constraint must hold for any start times within the windows
+    auto M = [&problem, &p, &earliest, &latest](int i, int j, int l) -> double {
+        return std::max(0.0, latest[i] + p[i] + problem.setup(i, j, l) - earliest[j]);
+    };
+
+    // Solve the problem with the MIP solver
+    auto model = MIPSolver::create(solver_name);
+    model->configure(opt_input);
+
+    // Decision variables
+    auto x = std::vector< std::vector< std::vector<MIPVar> > >(n + 1,
+            std::vector< std::vector<MIPVar> >(n + 1, std::vector<MIPVar>(m + 1)));
+    auto t = std::vector<MIPVar>(n + 1);
+    std::vector<MIPVar> binaries;
+
+    for (int i = 0; i <= n; ++i) {
+        if (technology[i] != Technology::REMOTE) {
+            for (int j = 1; j <= n; ++j) {
+                if (j != i && technology[j] != Technology::REMOTE) {
                     for (int l = 1; l <= m; ++l) {
-                        max_c = std::max(max_c, s[i][j][l]);
+                        x[i][j][l] = model->add_var(0, 1, VarType::BINARY);
+                        binaries.push_back(x[i][j][l]);
                     }
                 }
             }
         }
-        M += max_c + p[j];
     }
 
-    // Solve the problem with Gurobi solver
-    GRBEnv* env = nullptr;
+    for (int i = 0; i <= n; ++i) {
+        t[i] = model->add_var(earliest[i], latest[i], VarType::CONTINUOUS);
+    }
 
-    try {
+    MIPVar T = model->add_var(0, MIP_INFINITY, VarType::CONTINUOUS);
 
-        // Gurobi environment and model
-        env = new GRBEnv();
-        GRBModel model(*env);
+    // Translate a schedule into values of the variables. A schedule cannot be
+    // represented if any start time is out of the window of its switch, as
+    // the big-M values assume the windows hold (this only happens to
+    // schedules worse than the heuristic solution).
+    auto translate = [&](const Schedule& candidate, std::vector<MIPVar>& vars, std::vector<double>& values) -> bool {
+        auto t_ = problem.start_time(candidate);
+        double makespan_ = problem.makespan(candidate);
 
-        // Set some settings of Gurobi solver
-        model.getEnv().set(GRB_IntParam_LogToConsole, (verbose ? 1 : 0));
-        model.getEnv().set(GRB_IntParam_OutputFlag, (verbose ? 1 : 0));
-        model.getEnv().set(GRB_IntParam_Threads, threads);
-        model.getEnv().set(GRB_DoubleParam_TimeLimit, time_limit);
-        model.getEnv().set(GRB_DoubleParam_NodeLimit, iterations_limit);
+        bool valid = common::less_or_equal(makespan_, windows.upper_bound());
+        for (int i = 1; i <= n; ++i) {
+            valid = valid && t_[i] >= earliest[i] && t_[i] <= latest[i];
+        }
 
-        // Allocate memory for decision variables
-        GRBVar*** x = new GRBVar**[n + 1];
-        for (int i = 0; i <= n; ++i) {
-            x[i] = new GRBVar*[n + 1];
-            for (int j = 0; j <= n; ++j) {
-                x[i][j] = new GRBVar[m + 1];
+        // Team and previous switch of each manual switch
+        std::vector<int> team(n + 1, 0);
+        std::vector<int> previous(n + 1, 0);
+        for (int l = 1; l <= m; ++l) {
+            int i = 0;
+            for (auto j : candidate[l]) {
+                team[j] = l;
+                previous[j] = i;
+                i = j;
             }
         }
 
-        GRBVar* t = new GRBVar[n + 1];
-
-        // Decision variables
         for (int i = 0; i <= n; ++i) {
             if (technology[i] != Technology::REMOTE) {
                 for (int j = 1; j <= n; ++j) {
                     if (j != i && technology[j] != Technology::REMOTE) {
                         for (int l = 1; l <= m; ++l) {
-                            x[i][j][l] = model.addVar(0, 1, 0, GRB_BINARY);
+                            vars.push_back(x[i][j][l]);
+                            values.push_back(previous[j] == i && team[j] == l ? 1.0 : 0.0);
                         }
                     }
                 }
@@ -95,318 +130,192 @@ std::tuple<orcs::Schedule, double> orcs::MIPPrecedence::solve(const Problem& pro
         }
 
         for (int i = 0; i <= n; ++i) {
-            t[i] = model.addVar(0, GRB_INFINITY, 0, GRB_CONTINUOUS);
+            vars.push_back(t[i]);
+            values.push_back(t_[i]);
         }
 
-        GRBVar T = model.addVar(0, GRB_INFINITY, 0, GRB_CONTINUOUS);
-
-        model.update();
-
-        // Warm start
-        if (warm_start) {
+        vars.push_back(T);
+        values.push_back(makespan_);
 
-            // Initially, make all variables equal zero
-            for (int i = 0; i <= n; ++i) {
-                if (technology[i] != Technology::REMOTE) {
-                    for (int j = 1; j <= n; ++j) {
-                        if (j != i && technology[j] != Technology::REMOTE) {
-                            for (int l = 1; l <= m; ++l) {
-                                x[i][j][l].set(GRB_DoubleAttr_Start, 0.0);
-                            }
-                        }
-                    }
-                }
-            }
-
-            for (int i = 0; i <= n; ++i) {
-                t[i].set(GRB_DoubleAttr_Start, 0.0);
-            }
-
-            T.set(GRB_DoubleAttr_Start, 0.0);
-
-            // Get a heuristic solution
-            auto [schedule, makespan] = Greedy().solve(problem);
-            auto t_ = problem.start_time(schedule);
-
-            // Set initial value for the variables
-            T.set(GRB_DoubleAttr_Start, makespan);
-
-            for (int i = 0; i <= n; ++i) {
-                t[i].set(GRB_DoubleAttr_Start, t_[i]);
-            }
+        return valid;
+    };
 
-            for (int l = 1; l <= m; ++l) {
-                int i = 0;
-                for (int idx = 0; idx < schedule[l].size(); ++idx) {
-                    int j = schedule[l][idx];
-                    x[i][j][l].set(GRB_DoubleAttr_Start, 1.0);
-                    i = j;
-                }
+    // Warm start (skipped if the heuristic solution cannot be represented)
+    std::string warm_start_msg = "no";
+    if (warm_start) {
+        std::vector<MIPVar> vars;
+        std::vector<double> values;
+        if (translate(schedule, vars, values)) {
+            for (std::size_t k = 0; k < vars.size(); ++k) {
+                model->set_start(vars[k], values[k]);
             }
+            warm_start_msg = "yes";
+        } else {
+            warm_start_msg = "skipped (the heuristic solution cannot be represented)";
         }
+    }
 
-        // Objective function
-        GRBLinExpr objective = T;
-        model.setObjective(objective, GRB_MINIMIZE);
-
-        // Constraints 1
-        for (int l = 1; l <= m; ++l) {
-            GRBLinExpr expr = 0;
-            for (int j = 1; j <= n; ++j) {
-                if (technology[j] != Technology::REMOTE) {
-                    expr += x[0][j][l];
-                }
-            }
-            model.addConstr(expr <= 1);
-        }
+    // Objective function
+    model->set_objective(T);
 
-        // Constraints 2
+    // Constraints 1
+    for (int l = 1; l <= m; ++l) {
+        LinExpr expr = 0;
         for (int j = 1; j <= n; ++j) {
             if (technology[j] != Technology::REMOTE) {
-                GRBLinExpr expr = 0;
-                for (int i = 0; i <= n; ++i) {
-                    if (i != j && technology[i] != Technology::REMOTE) {
-                        for (int l = 1; l <= m; ++l) {
-                            expr += x[i][j][l];
-                        }
-                    }
-                }
-                model.addConstr(expr == 1);
+                expr += x[0][j][l];
             }
         }
+        model->add_constr(expr <= 1);
+    }
 
-        // Constraints 3
-        for (int i = 1; i <= n; ++i) {
-            if (technology[i] != Technology::REMOTE) {
-                GRBLinExpr expr = 0;
-                for (int j = 1; j <= n; ++j) {
-                    if (j != i && technology[j] != Technology::REMOTE) {
-                        for (int l = 1; l <= m; ++l) {
-                            expr += x[i][j][l];
-                        }
+    // Constraints 2
+    for (int j = 1; j <= n; ++j) {
+        if (technology[j] != Technology::REMOTE) {
+            LinExpr expr = 0;
+            for (int i = 0; i <= n; ++i) {
+                if (i != j && technology[i] != Technology::REMOTE) {
+                    for (int l = 1; l <= m; ++l) {
+                        expr += x[i][j][l];
                     }
                 }
-                model.addConstr(expr <= 1);
             }
+            model->add_constr(expr == 1);
         }
+    }
 
-        // Constraints 4
-        for (int i = 1; i <= n; ++i) {
-            if (technology[i] != Technology::REMOTE) {
-                for (int j = 1; j <= n; ++j) {
-                    if (j != i && technology[j] != Technology::REMOTE) {
-                        for (int l = 1; l <= m; ++l) {
-                            GRBLinExpr expr = 0;
-                            for (int h = 0; h <= n; ++h) {
-                                if (h != i && h != j && technology[h] != Technology::REMOTE) {
-                                    expr += x[h][i][l];
-                                }
-                            }
-                            model.addConstr(expr >= x[i][j][l]);
-                        }
+    // Constraints 3
+    for (int i = 1; i <= n; ++i) {
+        if (technology[i] != Technology::REMOTE) {
+            LinExpr expr = 0;
+            for (int j = 1; j <= n; ++j) {
+                if (j != i && technology[j] != Technology::REMOTE) {
+                    for (int l = 1; l <= m; ++l) {
+                        expr += x[i][j][l];
                     }
                 }
             }
+            model->add_constr(expr <= 1);
         }
+    }
 
-        // Constraints 5
-        model.addConstr(t[0] == 0);
-
-        // Constraints 6
-        for (int i = 0; i <= n; ++i) {
-            if (technology[i] != Technology::REMOTE) {
-                for (int j = 1; j <= n; ++j) {
-                    if (j != i && technology[j] != Technology::REMOTE) {
-                        for (int l = 1; l <= m; ++l) {
-                            model.addConstr(t[j] >= t[i] + p[i] + s[i][j][l] - M * (1 - x[i][j][l]));
+    // Constraints 4
+    for (int i = 1; i <= n; ++i) {
+        if (technology[i] != Technology::REMOTE) {
+            for (int j = 1; j <= n; ++j) {
+                if (j != i && technology[j] != Technology::REMOTE) {
+                    for (int l = 1; l <= m; ++l) {
+                        LinExpr expr = 0;
+                        for (int h = 0; h <= n; ++h) {
+                            if (h != i && h != j && technology[h] != Technology::REMOTE) {
+                                expr += x[h][i][l];
+                            }
                         }
+                        model->add_constr(expr >= x[i][j][l]);
                     }
                 }
             }
         }
+    }
 
-        // Constraints 7
-        for (int j = 1; j <= n; ++j) {
-            for (auto i : predecessors[j]) {
-                model.addConstr(t[j] >= t[i] + p[i]);
-            }
-        }
-
-        // Constraints 8
-        for (int i = 1; i <= n; ++i) {
-            model.addConstr(T >= t[i] + p[i]);
-        }
+    // Constraints 5
+    model->add_constr(t[0] == 0);
 
-        // Preprocessing: fix to zero variables x[j][i][l] which will never be
-        // equal to one due to the precedence constraints
-        model.update();
-        for (int i = 1; i <= n; ++i) {
-            if (technology[i] != Technology::REMOTE) {
-                for (int j = 1; j <= n; ++j) {
-                    if (j != i && technology[j] != Technology::REMOTE) {
-                        if (problem.precedence[i][j]) {
-                            for (int l = 1; l <= m; ++l) {
-                                x[j][i][l].set(GRB_DoubleAttr_UB, 0);
-                            }
-                        }
+    // Constraints 6
+    for (int i = 0; i <= n; ++i) {
+        if (technology[i] != Technology::REMOTE) {
+            for (int j = 1; j <= n; ++j) {
+                if (j != i && technology[j] != Technology::REMOTE) {
+                    for (int l = 1; l <= m; ++l) {
+                        model->add_constr(t[j] >= t[i] + p[i] + problem.setup(i, j, l) - M(i, j, l) * (1 - x[i][j][l]));
                     }
                 }
             }
         }
+    }
 
-        // Solve the model
-        model.optimize();
+    // Constraints 7
+    for (int j = 1; j <= n; ++j) {
+        for (auto i : predecessors[j]) {
+            model->add_constr(t[j] >= t[i] + p[i]);
+        }
+    }
 
-        // Get the best solution found (if any)
-        if (model.get(GRB_IntAttr_SolCount) > 0) {
+    // Constraints 8
+    for (int i = 1; i <= n; ++i) {
+        model->add_constr(T >= t[i] + p[i]);
+    }
 
+    // Preprocessing: fix to zero variables x[j][i][l] which will never be
+    // equal to one due to the precedence constraints
+    for (int i = 1; i <= n; ++i) {
+        if (technology[i] != Technology::REMOTE) {
             for (int j = 1; j <= n; ++j) {
-                if (technology[j] != Technology::REMOTE) {
-                    for (int i = 0; i <= n; ++i) {
-                        if (i != j && technology[i] != Technology::REMOTE)  {
-                            for (int l = 1; l <= m; ++l) {
-                                if (x[i][j][l].get(GRB_DoubleAttr_X) > 0.5) {
-                                    solution[l].push_back(j);
-                                }
-                            }
+                if (j != i && technology[j] != Technology::REMOTE) {
+                    if (problem.precedence(i, j)) {
+                        for (int l = 1; l <= m; ++l) {
+                            model->set_upper_bound(x[j][i][l], 0);
                         }
                     }
-                } else {
-                    solution[0].push_back(j);
                 }
             }
-
-            for (int l = 0; l <= m; ++l) {
-                std::sort(solution[l].begin(), solution[l].end(),
-                          [&t](int first, int second) -> bool {
-                              return (t[first].get(GRB_DoubleAttr_X) < t[second].get(GRB_DoubleAttr_X));
-                          });
-            }
         }
+    }
 
-        // Store optional output
-        if (opt_output != nullptr) {
-
-            // Status of the optimization process
-            int status = model.get(GRB_IntAttr_Status);
-            switch (status) {
-
-                case GRB_OPTIMAL:
-                    opt_output->add("Status", "OPTIMAL");
-                    break;
-
-                case GRB_INFEASIBLE:
-                    opt_output->add("Status", "INFEASIBLE");
-                    break;
-
-                case GRB_UNBOUNDED:
-                    opt_output->add("Status", "UNBOUNDED");
-                    break;
-
-                case GRB_INF_OR_UNBD:
-                    opt_output->add("Status", "INF_OR_UNBD");
-                    break;
-
-                default:
-                    if (model.get(GRB_IntAttr_SolCount) > 0) {
-                        opt_output->add("Status", "SUBOPTIMAL");
-                    } else {
-                        opt_output->add("Status", "UNKNOWN");
-                    }
-            }
-
-            // Objective function of the best solution found (if any)
-            if (model.get(GRB_IntAttr_SolCount) > 0) {
-                opt_output->add("MIP objective", model.get(GRB_DoubleAttr_ObjVal));
-            }
-
-            // Number of iterations (or MIP nodes)
-            try {
-                opt_output->add("Iterations", model.get(GRB_DoubleAttr_NodeCount));
-            } catch (...) {
-                // Do nothing
-            }
-
-            // MIP gap
-            try {
-                double mip_gap = model.get(GRB_DoubleAttr_MIPGap);
-                if (common::equal(mip_gap, GRB_INFINITY)) {
-                    opt_output->add("MIP gap", "Infinity");
-                } else {
-                    opt_output->add("MIP gap", mip_gap);
-                }
-            } catch (...) {
-                // Do nothing
-            }
-
-            // Runtime
-            opt_output->add("MIP runtime (s)", model.get(GRB_DoubleAttr_Runtime));
+    // Run the ILS-based heuristic concurrently and inject its solutions (if
+    // the solver accepts heuristic solutions)
+    concurrent = concurrent && model->supports_heuristic_solutions();
+    ConcurrentILS heuristic(translate);
+    if (concurrent) {
+        model->set_callback(&heuristic);
+        heuristic.start(problem, opt_input);
+    }
 
-            // Solve the linear relaxation
-            if (solve_lr) {
+    // Solve the model
+    model->optimize();
+    heuristic.stop();
 
-                // Reset Gurobi solver
-                model.getEnv().set(GRB_IntParam_OutputFlag, 0);
-                model.getEnv().set(GRB_DoubleParam_TimeLimit, GRB_INFINITY);
-                model.reset();
+    // Get the best solution found (if any)
+    if (model->has_solution()) {
 
-                // Relax the integrality constraints
+        for (int j = 1; j <= n; ++j) {
+            if (technology[j] != Technology::REMOTE) {
                 for (int i = 0; i <= n; ++i) {
-                    if (technology[i] != Technology::REMOTE) {
-                        for (int j = 1; j <= n; ++j) {
-                            if (j != i && technology[j] != Technology::REMOTE) {
-                                for (int l = 1; l <= m; ++l) {
-                                    x[i][j][l].set(GRB_CharAttr_VType, GRB_CONTINUOUS);
-                                }
+                    if (i != j && technology[i] != Technology::REMOTE)  {
+                        for (int l = 1; l <= m; ++l) {
+                            if (model->value(x[i][j][l]) > 0.5) {
+                                solution[l].push_back(j);
                             }
                         }
                     }
                 }
-
-                // Solve the linear relaxation
-                model.optimize();
-
-                // Value of the objective function
-                if (model.get(GRB_IntAttr_SolCount) > 0) {
-                    opt_output->add("LP objective", model.get(GRB_DoubleAttr_ObjVal));
-                }
-
-                // Runtime
-                opt_output->add("LP runtime (s)", model.get(GRB_DoubleAttr_Runtime));
+            } else {
+                solution[0].push_back(j);
             }
         }
 
-        // Deallocate resources
-        for (int i = 0; i <= n; ++i) {
-            for (int j = 0; j <= n; ++j) {
-                delete[] x[i][j];
-                x[i][j] = nullptr;
-            }
-            delete[] x[i];
-            x[i] = nullptr;
+        for (int l = 0; l <= m; ++l) {
+            std::sort(solution[l].begin(), solution[l].end(),
+                      [&model, &t](int first, int second) -> bool {
+                          return (model->value(t[first]) < model->value(t[second]));
+                      });
         }
-        delete[] x;
-        x = nullptr;
-
-        delete[] t;
-        t = nullptr;
+    }
 
-    } catch (...) {
+    // Store optional output
+    if (opt_output != nullptr) {
+        model->store_mip_output(opt_output);
+        opt_output->add("Upper bound", makespan);
+        opt_output->add("Warm start", warm_start_msg);
 
-        // Deallocate resources
-        if (env != nullptr) {
-            delete env;
-            env = nullptr;
+        if (concurrent) {
+            opt_output->add("Injected solutions", heuristic.injected());
         }
 
-        // Re-throw the exception
-        throw;
-    }
-
-    // Deallocate resources
-    if (env != nullptr) {
-        delete env;
-        env = nullptr;
+        // Solve the linear relaxation
+        if (solve_lr) {
+            model->solve_relaxation(binaries, opt_output);
+        }
     }
 
     // Return the solution found
@@ -0,0 +1,69 @@
+#include "mip_preprocessing.h"
+
+#include <string>
+
+#include "../heuristic/greedy.h"
+#include "../heuristic/neh.h"
+#include "../heuristic/ils.h"
+#include "../../util/common.h"
+
+
+std::tuple<orcs::Schedule, double> orcs::preprocessing::heuristic_solution(const Problem& problem,
+        const cxxproperties::Properties* opt_input) {
+
+    // Algorithm parameters
+    cxxproperties::Properties opt_aux;
+    if (opt_input == nullptr) {
+        opt_input = &opt_aux;
+    }
+
+    auto heuristic = opt_input->get<std::string>("horizon-heuristic", "neh");
+    auto ils_iterations = opt_input->get<long>("horizon-ils-iterations", 100);
+    auto initial_solution = opt_input->get<std::string>("initial-solution", "");
+
+    if (heuristic != "greedy" && heuristic != "neh" && heuristic != "ils") {
+        throw std::string("Invalid horizon heuristic.");
+    }
+
+    // Candidates are scored by the makespan of their schedules, since the
+    // bounds derived from the best one are only valid if it is attained
+    auto score = [&problem](const Schedule& schedule) -> std::tuple<Schedule, double> {
+        return std::make_tuple(schedule, problem.makespan(schedule));
+    };
+
+    // Greedy heuristic
+    auto best = score(std::get<0>(Greedy().solve(problem)));
+
+    // Initial solution given by the user
+    if (!initial_solution.empty()) {
+        auto solution = score(common::read_solution(initial_solution, problem));
+        if (common::less(std::get<1>(solution), std::get<1>(best))) {
+            best = solution;
+        }
+    }
+
+    // NEH-based heuristic
+    if (heuristic == "neh" || heuristic == "ils") {
+        auto solution = score(std::get<0>(NEH().solve(problem)));
+        if (common::less(std::get<1>(solution), std::get<1>(best))) {
+            best = solution;
+        }
+    }
+
+    // Short run of the ILS-based heuristic
+    if (heuristic == "ils") {
+        cxxproperties::Properties opt_ils;
+        opt_ils.add("seed", opt_input->get<int>("seed", 0));
+        opt_ils.add("iterations-limit", ils_iterations);
+        if (!initial_solution.empty()) {
+            opt_ils.add("initial-solution", initial_solution);
+        }
+
+        auto solution = score(std::get<0>(ILS().solve(problem, &opt_ils)));
+        if (common::less(std::get<1>(solution), std::get<1>(best))) {
+            best = solution;
+        }
+    }
+
+    return best;
+}
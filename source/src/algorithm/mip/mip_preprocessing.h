@@ -0,0 +1,40 @@
+#ifndef MANEUVER_SCHEDULING_MIP_PREPROCESSING_H
+#define MANEUVER_SCHEDULING_MIP_PREPROCESSING_H
+
+#include <tuple>
+
+#include <cxxproperties.hpp>
+
+#include "../../problem/problem.h"
+
+
+namespace orcs {
+
+    namespace preprocessing {
+
+        /**
+         * Build a heuristic solution used to bound the MIP formulations. The
+         * heuristic is selected by the option "horizon-heuristic": "greedy",
+         * "neh" (the best of the greedy and NEH-based heuristics) or "ils"
+         * (the best of those and a short run of the ILS-based heuristic,
+         * limited to "horizon-ils-iterations" iterations). If the option
+         * "initial-solution" names a solution file, the solution read from it
+         * is also a candidate (and the start solution of the ILS).
+         *
+         * @param   problem
+         *          The instance of the problem.
+         * @param   opt_input
+         *          Optional input arguments. It can be set to nullptr.
+         * @return  A tuple of two elements, in which the first is the
+         *          schedule and the second is its makespan (as given by
+         *          Problem::makespan).
+         */
+        std::tuple<Schedule, double> heuristic_solution(const Problem& problem,
+                const cxxproperties::Properties* opt_input);
+
+    }
+
+}
+
+
+#endif
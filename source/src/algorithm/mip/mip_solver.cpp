@@ -0,0 +1,234 @@
+#include "mip_solver.h"
+
+#include <cmath>
+#include <limits>
+
+#ifdef SCHD_WITH_GUROBI
+#include "mip_solver_gurobi.h"
+#endif
+
+#ifdef SCHD_WITH_HIGHS
+#include "mip_solver_highs.h"
+#endif
+
+
+orcs::LinExpr::LinExpr(double constant) : constant_(constant) {
+    // Do nothing
+}
+
+orcs::LinExpr::LinExpr(MIPVar var, double coef) : indices_{var.index}, coefs_{coef}, constant_(0.0) {
+    // Do nothing
+}
+
+void orcs::LinExpr::add_term(MIPVar var, double coef) {
+    indices_.push_back(var.index);
+    coefs_.push_back(coef);
+}
+
+const std::vector<int>& orcs::LinExpr::indices() const {
+    return indices_;
+}
+
+const std::vector<double>& orcs::LinExpr::coefs() const {
+    return coefs_;
+}
+
+double orcs::LinExpr::constant() const {
+    return constant_;
+}
+
+orcs::LinExpr& orcs::LinExpr::operator+=(MIPVar var) {
+    add_term(var, 1.0);
+    return *this;
+}
+
+orcs::LinExpr& orcs::LinExpr::operator+=(const LinExpr& expr) {
+    indices_.insert(indices_.end(), expr.indices_.begin(), expr.indices_.end());
+    coefs_.insert(coefs_.end(), expr.coefs_.begin(), expr.coefs_.end());
+    constant_ += expr.constant_;
+    return *this;
+}
+
+orcs::LinExpr& orcs::LinExpr::operator-=(const LinExpr& expr) {
+    indices_.insert(indices_.end(), expr.indices_.begin(), expr.indices_.end());
+    for (auto coef : expr.coefs_) {
+        coefs_.push_back(-coef);
+    }
+    constant_ -= expr.constant_;
+    return *this;
+}
+
+orcs::LinExpr& orcs::LinExpr::operator*=(double value) {
+    for (auto& coef : coefs_) {
+        coef *= value;
+    }
+    constant_ *= value;
+    return *this;
+}
+
+orcs::LinExpr orcs::operator+(LinExpr first, const LinExpr& second) {
+    return first += second;
+}
+
+orcs::LinExpr orcs::operator-(LinExpr first, const LinExpr& second) {
+    return first -= second;
+}
+
+orcs::LinExpr orcs::operator-(LinExpr expr) {
+    return expr *= -1.0;
+}
+
+orcs::LinExpr orcs::operator*(double value, LinExpr expr) {
+    return expr *= value;
+}
+
+orcs::LinExpr orcs::operator*(LinExpr expr, double value) {
+    return expr *= value;
+}
+
+namespace {
+
+    // Move all terms to the left-hand side and the constant to the right-hand
+    // side of the constraint
+    orcs::LinConstr make_constr(const orcs::LinExpr& lhs, orcs::Sense sense, const orcs::LinExpr& rhs) {
+        orcs::LinExpr expr = lhs - rhs;
+        double constant = expr.constant();
+        expr -= constant;
+        return {expr, sense, -constant};
+    }
+
+}
+
+orcs::LinConstr orcs::operator<=(const LinExpr& lhs, const LinExpr& rhs) {
+    return make_constr(lhs, Sense::LESS_EQUAL, rhs);
+}
+
+orcs::LinConstr orcs::operator>=(const LinExpr& lhs, const LinExpr& rhs) {
+    return make_constr(lhs, Sense::GREATER_EQUAL, rhs);
+}
+
+orcs::LinConstr orcs::operator==(const LinExpr& lhs, const LinExpr& rhs) {
+    return make_constr(lhs, Sense::EQUAL, rhs);
+}
+
+std::unique_ptr<orcs::MIPSolver> orcs::MIPSolver::create(const std::string& name) {
+
+#ifdef SCHD_WITH_GUROBI
+    if (name == "gurobi") {
+        return std::make_unique<GurobiSolver>();
+    }
+#endif
+
+#ifdef SCHD_WITH_HIGHS
+    if (name == "highs") {
+        return std::make_unique<HighsSolver>();
+    }
+#endif
+
+    throw std::string("MIP solver \"" + name + "\" is not available.");
+}
+
+std::vector<std::string> orcs::MIPSolver::available() {
+    std::vector<std::string> names;
+
+#ifdef SCHD_WITH_GUROBI
+    names.push_back("gurobi");
+#endif
+
+#ifdef SCHD_WITH_HIGHS
+    names.push_back("highs");
+#endif
+
+    return names;
+}
+
+void orcs::MIPSolver::configure(const cxxproperties::Properties* opt_input) {
+
+    // Algorithm parameters
+    cxxproperties::Properties opt_aux;
+    if (opt_input == nullptr) {
+        opt_input = &opt_aux;
+    }
+
+    set_verbose(opt_input->get<bool>("verbose", false));
+    set_threads(opt_input->get<int>("threads", 0));
+    set_time_limit(opt_input->get<double>("time-limit", std::numeric_limits<double>::infinity()));
+    set_node_limit(opt_input->get<double>("iterations-limit", std::numeric_limits<double>::infinity()));
+}
+
+void orcs::MIPSolver::store_mip_output(cxxproperties::Properties* opt_output) {
+
+    // Status of the optimization process
+    switch (status()) {
+
+        case MIPStatus::OPTIMAL:
+            opt_output->add("Status", "OPTIMAL");
+            break;
+
+        case MIPStatus::INFEASIBLE:
+            opt_output->add("Status", "INFEASIBLE");
+            break;
+
+        case MIPStatus::UNBOUNDED:
+            opt_output->add("Status", "UNBOUNDED");
+            break;
+
+        case MIPStatus::INF_OR_UNBD:
+            opt_output->add("Status", "INF_OR_UNBD");
+            break;
+
+        default:
+            if (has_solution()) {
+                opt_output->add("Status", "SUBOPTIMAL");
+            } else {
+                opt_output->add("Status", "UNKNOWN");
+            }
+    }
+
+    // Objective function of the best solution found (if any)
+    if (has_solution()) {
+        opt_output->add("MIP objective", objective());
+    }
+
+    // Number of iterations (or MIP nodes)
+    double nodes = node_count();
+    if (nodes >= 0) {
+        opt_output->add("Iterations", nodes);
+    }
+
+    // MIP gap
+    double mip_gap = gap();
+    if (std::isinf(mip_gap)) {
+        opt_output->add("MIP gap", "Infinity");
+    } else if (!std::isnan(mip_gap)) {
+        opt_output->add("MIP gap", mip_gap);
+    }
+
+    // Runtime
+    opt_output->add("MIP runtime (s)", runtime());
+}
+
+void orcs::MIPSolver::solve_relaxation(const std::vector<MIPVar>& vars, cxxproperties::Properties* opt_output) {
+
+    // Reset the solver
+    set_verbose(false);
+    set_time_limit(std::numeric_limits<double>::infinity());
+    set_callback(nullptr);
+    reset();
+
+    // Relax the integrality constraints
+    for (auto var : vars) {
+        set_type(var, VarType::CONTINUOUS);
+    }
+
+    // Solve the linear relaxation
+    optimize();
+
+    // Value of the objective function
+    if (has_solution()) {
+        opt_output->add("LP objective", objective());
+    }
+
+    // Runtime
+    opt_output->add("LP runtime (s)", runtime());
+}
@@ -0,0 +1,415 @@
+#ifndef MANEUVER_SCHEDULING_MIP_SOLVER_H
+#define MANEUVER_SCHEDULING_MIP_SOLVER_H
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <cxxproperties.hpp>
+
+
+namespace orcs {
+
+    /**
+     * Infinite bound of variables.
+     */
+    constexpr double MIP_INFINITY = std::numeric_limits<double>::infinity();
+
+    /**
+     * Type of a decision variable.
+     */
+    enum class VarType {
+        CONTINUOUS,
+        BINARY,
+        INTEGER
+    };
+
+    /**
+     * Sense of a linear constraint.
+     */
+    enum class Sense {
+        LESS_EQUAL,
+        GREATER_EQUAL,
+        EQUAL
+    };
+
+    /**
+     * Status of the optimization process.
+     */
+    enum class MIPStatus {
+        OPTIMAL,
+        INFEASIBLE,
+        UNBOUNDED,
+        INF_OR_UNBD,
+        LIMIT,
+        UNKNOWN
+    };
+
+    /**
+     * Handle of a decision variable. It is the index of the variable in the
+     * model that created it.
+     */
+    struct MIPVar {
+        int index = -1;
+    };
+
+    /**
+     * Linear expression over the decision variables of a model.
+     */
+    class LinExpr {
+
+    public:
+
+        /**
+         * Constructor of a constant expression.
+         *
+         * @param   constant
+         *          The value of the expression.
+         */
+        LinExpr(double constant = 0.0);
+
+        /**
+         * Constructor of an expression with a single term.
+         *
+         * @param   var
+         *          The variable.
+         * @param   coef
+         *          The coefficient of the variable.
+         */
+        LinExpr(MIPVar var, double coef = 1.0);
+
+        /**
+         * Add a term to the expression. Repeated variables are not merged.
+         *
+         * @param   var
+         *          The variable.
+         * @param   coef
+         *          The coefficient of the variable.
+         */
+        void add_term(MIPVar var, double coef);
+
+        /**
+         * Return the indices of the variables in the expression.
+         *
+         * @return  A vector with the indices of the variables.
+         */
+        const std::vector<int>& indices() const;
+
+        /**
+         * Return the coefficients of the variables in the expression.
+         *
+         * @return  A vector with the coefficients, in the same order of the
+         *          indices of the variables.
+         */
+        const std::vector<double>& coefs() const;
+
+        /**
+         * Return the constant term of the expression.
+         *
+         * @return  The constant term.
+         */
+        double constant() const;
+
+        LinExpr& operator+=(MIPVar var);
+        LinExpr& operator+=(const LinExpr& expr);
+        LinExpr& operator-=(const LinExpr& expr);
+        LinExpr& operator*=(double value);
+
+    private:
+
+        std::vector<int> indices_;
+        std::vector<double> coefs_;
+        double constant_;
+
+    };
+
+    LinExpr operator+(LinExpr first, const LinExpr& second);
+    LinExpr operator-(LinExpr first, const LinExpr& second);
+    LinExpr operator-(LinExpr expr);
+    LinExpr operator*(double value, LinExpr expr);
+    LinExpr operator*(LinExpr expr, double value);
+
+    /**
+     * Linear constraint in the form expr (sense) rhs, in which the expression
+     * has no constant term.
+     */
+    struct LinConstr {
+        LinExpr expr;
+        Sense sense;
+        double rhs;
+    };
+
+    LinConstr operator<=(const LinExpr& lhs, const LinExpr& rhs);
+    LinConstr operator>=(const LinExpr& lhs, const LinExpr& rhs);
+    LinConstr operator==(const LinExpr& lhs, const LinExpr& rhs);
+
+    /**
+     * Access to the solver given to callbacks during the optimization.
+     */
+    class MIPCallbackContext {
+
+    public:
+
+        /**
+         * Point of the optimization in which the callback is called.
+         */
+        enum class Where {
+
+            // A new incumbent solution was found. Its values can be queried
+            // and lazy constraints can be added to cut it off.
+            SOLUTION,
+
+            // A node of the branch-and-bound tree is being explored. The
+            // values of its relaxation can be queried, cuts can be added and
+            // heuristic solutions can be injected.
+            NODE
+        };
+
+        virtual ~MIPCallbackContext() = default;
+
+        /**
+         * Return the point of the optimization in which the callback is
+         * called.
+         *
+         * @return  The point of the optimization.
+         */
+        virtual Where where() const = 0;
+
+        /**
+         * Return the value of a variable in the new incumbent solution (at
+         * Where::SOLUTION) or in the relaxation of the node (at Where::NODE).
+         *
+         * @param   var
+         *          The variable.
+         * @return  The value of the variable.
+         */
+        virtual double value(MIPVar var) = 0;
+
+        /**
+         * Return the objective value of the best solution found so far.
+         *
+         * @return  The objective value, or infinity if no solution was found.
+         */
+        virtual double best_objective() = 0;
+
+        /**
+         * Add a lazy constraint. Only available at Where::SOLUTION, if the
+         * callback was set with lazy constraints enabled.
+         *
+         * @param   constr
+         *          The constraint.
+         */
+        virtual void add_lazy(const LinConstr& constr) = 0;
+
+        /**
+         * Add a cut, i.e., a constraint valid for all integer solutions that
+         * cuts off the relaxation of the node. Only available at Where::NODE,
+         * if the callback was set with lazy constraints enabled.
+         *
+         * @param   constr
+         *          The constraint.
+         */
+        virtual void add_cut(const LinConstr& constr) = 0;
+
+        /**
+         * Inject a (partial) heuristic solution. Only available at
+         * Where::NODE.
+         *
+         * @param   vars
+         *          The variables whose values are given.
+         * @param   values
+         *          The values of the variables.
+         */
+        virtual void set_solution(const std::vector<MIPVar>& vars, const std::vector<double>& values) = 0;
+
+    };
+
+    /**
+     * Interface implemented by user callbacks.
+     */
+    class MIPCallback {
+
+    public:
+
+        virtual ~MIPCallback() = default;
+
+        /**
+         * Called by the solver during the optimization.
+         *
+         * @param   context
+         *          Access to the solver.
+         */
+        virtual void callback(MIPCallbackContext& context) = 0;
+
+    };
+
+    /**
+     * Interface to a mixed integer programming (MIP) solver. Models are
+     * minimization problems built variable by variable and constraint by
+     * constraint, so the MIP formulations are written independently of the
+     * solver used to solve them.
+     */
+    class MIPSolver {
+
+    public:
+
+        virtual ~MIPSolver() = default;
+
+        /**
+         * Create a solver.
+         *
+         * @param   name
+         *          Name of the solver (see available()).
+         * @return  The solver.
+         */
+        static std::unique_ptr<MIPSolver> create(const std::string& name);
+
+        /**
+         * Return the names of the solvers the project was built with. The
+         * first one is the default solver.
+         *
+         * @return  A vector with the names of the solvers.
+         */
+        static std::vector<std::string> available();
+
+        /**
+         * Set the parameters of the solver from the options given to the MIP
+         * formulations ("verbose", "threads", "time-limit" and
+         * "iterations-limit").
+         *
+         * @param   opt_input
+         *          Optional input arguments.
+         */
+        void configure(const cxxproperties::Properties* opt_input);
+
+        /**
+         * Store the results of the last optimization (status, objective
+         * value, number of nodes, MIP gap and runtime) in the optional output.
+         *
+         * @param   opt_output
+         *          Optional output arguments.
+         */
+        void store_mip_output(cxxproperties::Properties* opt_output);
+
+        /**
+         * Relax the integrality of the given variables, solve the linear
+         * relaxation and store its objective value and runtime in the optional
+         * output.
+         *
+         * @param   vars
+         *          The integer variables of the model.
+         * @param   opt_output
+         *          Optional output arguments.
+         */
+        void solve_relaxation(const std::vector<MIPVar>& vars, cxxproperties::Properties* opt_output);
+
+        // Parameters
+        virtual void set_verbose(bool verbose) = 0;
+        virtual void set_threads(int threads) = 0;
+        virtual void set_time_limit(double time_limit) = 0;
+        virtual void set_node_limit(double node_limit) = 0;
+
+        /**
+         * Add a variable to the model.
+         *
+         * @param   lb
+         *          Lower bound of the variable.
+         * @param   ub
+         *          Upper bound of the variable.
+         * @param   type
+         *          Type of the variable.
+         * @return  The variable.
+         */
+        virtual MIPVar add_var(double lb, double ub, VarType type) = 0;
+
+        /**
+         * Add a constraint to the model.
+         *
+         * @param   constr
+         *          The constraint.
+         */
+        virtual void add_constr(const LinConstr& constr) = 0;
+
+        /**
+         * Set the objective function (minimized).
+         *
+         * @param   expr
+         *          The objective function.
+         */
+        virtual void set_objective(const LinExpr& expr) = 0;
+
+        // Attributes of variables
+        virtual void set_upper_bound(MIPVar var, double ub) = 0;
+        virtual void set_type(MIPVar var, VarType type) = 0;
+        virtual void set_start(MIPVar var, double value) = 0;
+
+        /**
+         * Set the callback called during the optimization.
+         *
+         * @param   callback
+         *          The callback, or nullptr to remove it.
+         * @param   lazy_constraints
+         *          Whether the callback adds lazy constraints (and cuts).
+         */
+        virtual void set_callback(MIPCallback* callback, bool lazy_constraints = false) = 0;
+
+        /**
+         * Whether the solver supports lazy constraints added by callbacks.
+         *
+         * @return  True if lazy constraints are supported, false otherwise.
+         */
+        virtual bool supports_lazy_constraints() const = 0;
+
+        /**
+         * Whether the solver accepts heuristic solutions injected by
+         * callbacks.
+         *
+         * @return  True if heuristic solutions are supported, false otherwise.
+         */
+        virtual bool supports_heuristic_solutions() const = 0;
+
+        /**
+         * Solve the model.
+         */
+        virtual void optimize() = 0;
+
+        /**
+         * Discard the results of the last optimization, so the model is
+         * solved from scratch by the next one.
+         */
+        virtual void reset() = 0;
+
+        // Results of the last optimization
+        virtual MIPStatus status() = 0;
+        virtual bool has_solution() = 0;
+        virtual double value(MIPVar var) = 0;
+        virtual double objective() = 0;
+
+        /**
+         * Return the relative MIP optimality gap.
+         *
+         * @return  The MIP gap (it may be infinity), or NaN if not available.
+         */
+        virtual double gap() = 0;
+
+        /**
+         * Return the number of branch-and-bound nodes explored.
+         *
+         * @return  The number of nodes, or a negative value if not available.
+         */
+        virtual double node_count() = 0;
+
+        /**
+         * Return the runtime of the last optimization.
+         *
+         * @return  The runtime in seconds.
+         */
+        virtual double runtime() = 0;
+
+    };
+
+}
+
+
+#endif
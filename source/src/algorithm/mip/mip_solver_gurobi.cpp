@@ -0,0 +1,263 @@
+#include "mip_solver_gurobi.h"
+
+#include <cmath>
+#include <limits>
+
+
+namespace {
+
+    char to_gurobi(orcs::VarType type) {
+        switch (type) {
+            case orcs::VarType::BINARY:
+                return GRB_BINARY;
+            case orcs::VarType::INTEGER:
+                return GRB_INTEGER;
+            default:
+                return GRB_CONTINUOUS;
+        }
+    }
+
+    char to_gurobi(orcs::Sense sense) {
+        switch (sense) {
+            case orcs::Sense::LESS_EQUAL:
+                return GRB_LESS_EQUAL;
+            case orcs::Sense::GREATER_EQUAL:
+                return GRB_GREATER_EQUAL;
+            default:
+                return GRB_EQUAL;
+        }
+    }
+
+    // Infinite values are given to Gurobi as GRB_INFINITY
+    double to_gurobi(double value) {
+        return std::isinf(value) ? (value > 0 ? GRB_INFINITY : -GRB_INFINITY) : value;
+    }
+
+}
+
+/*
+ * Adapter between Gurobi callbacks and the callbacks of the abstraction.
+ */
+class orcs::GurobiSolver::Callback : public GRBCallback, public MIPCallbackContext {
+
+public:
+
+    Callback(const GurobiSolver& solver, MIPCallback* callback) : solver_(solver), callback_(callback) {
+        // Do nothing
+    }
+
+    Where where() const override {
+        return where_;
+    }
+
+    double value(MIPVar var) override {
+        if (where_ == Where::SOLUTION) {
+            return getSolution(solver_.vars()[var.index]);
+        }
+        return getNodeRel(solver_.vars()[var.index]);
+    }
+
+    double best_objective() override {
+        double objective = getDoubleInfo(where_ == Where::SOLUTION ? GRB_CB_MIPSOL_OBJBST : GRB_CB_MIPNODE_OBJBST);
+        return objective >= GRB_INFINITY ? std::numeric_limits<double>::infinity() : objective;
+    }
+
+    void add_lazy(const LinConstr& constr) override {
+        addLazy(solver_.convert(constr.expr), to_gurobi(constr.sense), constr.rhs);
+    }
+
+    void add_cut(const LinConstr& constr) override {
+        addCut(solver_.convert(constr.expr), to_gurobi(constr.sense), constr.rhs);
+    }
+
+    void set_solution(const std::vector<MIPVar>& vars, const std::vector<double>& values) override {
+        for (std::size_t k = 0; k < vars.size(); ++k) {
+            setSolution(solver_.vars()[vars[k].index], values[k]);
+        }
+    }
+
+protected:
+
+    void callback() override {
+        if (GRBCallback::where == GRB_CB_MIPSOL) {
+            where_ = Where::SOLUTION;
+            callback_->callback(*this);
+
+        } else if (GRBCallback::where == GRB_CB_MIPNODE && getIntInfo(GRB_CB_MIPNODE_STATUS) == GRB_OPTIMAL) {
+            where_ = Where::NODE;
+            callback_->callback(*this);
+        }
+    }
+
+private:
+
+    const GurobiSolver& solver_;
+    MIPCallback* callback_;
+    Where where_ = Where::SOLUTION;
+
+};
+
+orcs::GurobiSolver::GurobiSolver() : pending_update_(false) {
+    env_ = std::make_unique<GRBEnv>();
+    model_ = std::make_unique<GRBModel>(*env_);
+}
+
+orcs::GurobiSolver::~GurobiSolver() = default;
+
+void orcs::GurobiSolver::set_verbose(bool verbose) {
+    model_->getEnv().set(GRB_IntParam_LogToConsole, (verbose ? 1 : 0));
+    model_->getEnv().set(GRB_IntParam_OutputFlag, (verbose ? 1 : 0));
+}
+
+void orcs::GurobiSolver::set_threads(int threads) {
+    model_->getEnv().set(GRB_IntParam_Threads, threads);
+}
+
+void orcs::GurobiSolver::set_time_limit(double time_limit) {
+    model_->getEnv().set(GRB_DoubleParam_TimeLimit, to_gurobi(time_limit));
+}
+
+void orcs::GurobiSolver::set_node_limit(double node_limit) {
+    model_->getEnv().set(GRB_DoubleParam_NodeLimit, to_gurobi(node_limit));
+}
+
+orcs::MIPVar orcs::GurobiSolver::add_var(double lb, double ub, VarType type) {
+    vars_.push_back(model_->addVar(to_gurobi(lb), to_gurobi(ub), 0, to_gurobi(type)));
+    pending_update_ = true;
+    return {static_cast<int>(vars_.size()) - 1};
+}
+
+void orcs::GurobiSolver::add_constr(const LinConstr& constr) {
+    model_->addConstr(convert(constr.expr), to_gurobi(constr.sense), constr.rhs);
+}
+
+void orcs::GurobiSolver::set_objective(const LinExpr& expr) {
+    GRBLinExpr objective = convert(expr);
+    objective += expr.constant();
+    model_->setObjective(objective, GRB_MINIMIZE);
+}
+
+void orcs::GurobiSolver::set_upper_bound(MIPVar var, double ub) {
+    update();
+    vars_[var.index].set(GRB_DoubleAttr_UB, to_gurobi(ub));
+}
+
+void orcs::GurobiSolver::set_type(MIPVar var, VarType type) {
+    update();
+    vars_[var.index].set(GRB_CharAttr_VType, to_gurobi(type));
+}
+
+void orcs::GurobiSolver::set_start(MIPVar var, double value) {
+    update();
+    vars_[var.index].set(GRB_DoubleAttr_Start, value);
+}
+
+void orcs::GurobiSolver::set_callback(MIPCallback* callback, bool lazy_constraints) {
+    if (callback != nullptr) {
+        callback_ = std::make_unique<Callback>(*this, callback);
+        model_->setCallback(callback_.get());
+    } else {
+        model_->setCallback(nullptr);
+        callback_.reset();
+    }
+
+    model_->getEnv().set(GRB_IntParam_LazyConstraints, (callback != nullptr && lazy_constraints ? 1 : 0));
+    model_->getEnv().set(GRB_IntParam_PreCrush, (callback != nullptr && lazy_constraints ? 1 : 0));
+}
+
+bool orcs::GurobiSolver::supports_lazy_constraints() const {
+    return true;
+}
+
+bool orcs::GurobiSolver::supports_heuristic_solutions() const {
+    return true;
+}
+
+void orcs::GurobiSolver::optimize() {
+    update();
+    model_->optimize();
+}
+
+void orcs::GurobiSolver::reset() {
+    update();
+    model_->reset();
+}
+
+orcs::MIPStatus orcs::GurobiSolver::status() {
+    switch (model_->get(GRB_IntAttr_Status)) {
+
+        case GRB_OPTIMAL:
+            return MIPStatus::OPTIMAL;
+
+        case GRB_INFEASIBLE:
+            return MIPStatus::INFEASIBLE;
+
+        case GRB_UNBOUNDED:
+            return MIPStatus::UNBOUNDED;
+
+        case GRB_INF_OR_UNBD:
+            return MIPStatus::INF_OR_UNBD;
+
+        case GRB_LOADED:
+            return MIPStatus::UNKNOWN;
+
+        default:
+            return MIPStatus::LIMIT;
+    }
+}
+
+bool orcs::GurobiSolver::has_solution() {
+    return model_->get(GRB_IntAttr_SolCount) > 0;
+}
+
+double orcs::GurobiSolver::value(MIPVar var) {
+    return vars_[var.index].get(GRB_DoubleAttr_X);
+}
+
+double orcs::GurobiSolver::objective() {
+    return model_->get(GRB_DoubleAttr_ObjVal);
+}
+
+double orcs::GurobiSolver::gap() {
+    try {
+        double mip_gap = model_->get(GRB_DoubleAttr_MIPGap);
+        return mip_gap >= GRB_INFINITY ? std::numeric_limits<double>::infinity() : mip_gap;
+    } catch (const GRBException&) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+}
+
+double orcs::GurobiSolver::node_count() {
+    try {
+        return model_->get(GRB_DoubleAttr_NodeCount);
+    } catch (const GRBException&) {
+        return -1.0;
+    }
+}
+
+double orcs::GurobiSolver::runtime() {
+    return model_->get(GRB_DoubleAttr_Runtime);
+}
+
+GRBLinExpr orcs::GurobiSolver::convert(const LinExpr& expr) const {
+    std::vector<GRBVar> vars;
+    vars.reserve(expr.indices().size());
+    for (auto index : expr.indices()) {
+        vars.push_back(vars_[index]);
+    }
+
+    GRBLinExpr result;
+    result.addTerms(expr.coefs().data(), vars.data(), static_cast<int>(vars.size()));
+    return result;
+}
+
+const std::vector<GRBVar>& orcs::GurobiSolver::vars() const {
+    return vars_;
+}
+
+void orcs::GurobiSolver::update() {
+    if (pending_update_) {
+        model_->update();
+        pending_update_ = false;
+    }
+}
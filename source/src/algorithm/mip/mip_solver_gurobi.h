@@ -0,0 +1,87 @@
+#ifndef MANEUVER_SCHEDULING_MIP_SOLVER_GUROBI_H
+#define MANEUVER_SCHEDULING_MIP_SOLVER_GUROBI_H
+
+#include <memory>
+#include <vector>
+
+#include <gurobi_c++.h>
+
+#include "mip_solver.h"
+
+
+namespace orcs {
+
+    /**
+     * MIP solver backed by Gurobi.
+     */
+    class GurobiSolver : public MIPSolver {
+
+    public:
+
+        /**
+         * Constructor.
+         */
+        GurobiSolver();
+
+        /**
+         * Destructor.
+         */
+        ~GurobiSolver() override;
+
+        void set_verbose(bool verbose) override;
+        void set_threads(int threads) override;
+        void set_time_limit(double time_limit) override;
+        void set_node_limit(double node_limit) override;
+
+        MIPVar add_var(double lb, double ub, VarType type) override;
+        void add_constr(const LinConstr& constr) override;
+        void set_objective(const LinExpr& expr) override;
+
+        void set_upper_bound(MIPVar var, double ub) override;
+        void set_type(MIPVar var, VarType type) override;
+        void set_start(MIPVar var, double value) override;
+
+        void set_callback(MIPCallback* callback, bool lazy_constraints = false) override;
+        bool supports_lazy_constraints() const override;
+        bool supports_heuristic_solutions() const override;
+
+        void optimize() override;
+        void reset() override;
+
+        MIPStatus status() override;
+        bool has_solution() override;
+        double value(MIPVar var) override;
+        double objective() override;
+        double gap() override;
+        double node_count() override;
+        double runtime() override;
+
+        // Convert an expression of the abstraction into a Gurobi expression
+        // (without its constant term)
+        GRBLinExpr convert(const LinExpr& expr) const;
+
+        // Gurobi variables, indexed by the handles of the abstraction
+        const std::vector<GRBVar>& vars() const;
+
+    private:
+
+        class Callback;
+
+        std::unique_ptr<GRBEnv> env_;
+        std::unique_ptr<GRBModel> model_;
+        std::unique_ptr<Callback> callback_;
+        std::vector<GRBVar> vars_;
+
+        // Whether variables were added since the last model update
+        bool pending_update_;
+
+        // Process pending modifications of the model, so attributes of new
+        // variables can be set
+        void update();
+
+    };
+
+}
+
+
+#endif
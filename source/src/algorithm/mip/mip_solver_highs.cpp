@@ -0,0 +1,296 @@
+#include "mip_solver_highs.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include <interfaces/highs_c_api.h>
+
+
+namespace {
+
+    /*
+     * Context given to callbacks when HiGHS finds an improving solution.
+     */
+    class SolutionContext : public orcs::MIPCallbackContext {
+
+    public:
+
+        SolutionContext(const double* solution, double objective) : solution_(solution), objective_(objective) {
+            // Do nothing
+        }
+
+        Where where() const override {
+            return Where::SOLUTION;
+        }
+
+        double value(orcs::MIPVar var) override {
+            return solution_[var.index];
+        }
+
+        double best_objective() override {
+            return objective_;
+        }
+
+        void add_lazy(const orcs::LinConstr& constr) override {
+            throw std::string("Lazy constraints are not supported by HiGHS.");
+        }
+
+        void add_cut(const orcs::LinConstr& constr) override {
+            throw std::string("Cuts are not supported by HiGHS.");
+        }
+
+        void set_solution(const std::vector<orcs::MIPVar>& vars, const std::vector<double>& values) override {
+            throw std::string("Heuristic solutions are not supported by HiGHS.");
+        }
+
+    private:
+
+        const double* solution_;
+        double objective_;
+
+    };
+
+}
+
+orcs::HighsSolver::HighsSolver() : highs_(Highs_create()), callback_(nullptr), offset_(0.0),
+        row_start_{0}, is_mip_(false), solved_(false), runtime_(0.0) {
+    Highs_setBoolOptionValue(highs_, "output_flag", false);
+}
+
+orcs::HighsSolver::~HighsSolver() {
+    Highs_destroy(highs_);
+}
+
+void orcs::HighsSolver::set_verbose(bool verbose) {
+    Highs_setBoolOptionValue(highs_, "output_flag", verbose);
+}
+
+void orcs::HighsSolver::set_threads(int threads) {
+    Highs_setIntOptionValue(highs_, "threads", static_cast<HighsInt>(threads));
+}
+
+void orcs::HighsSolver::set_time_limit(double time_limit) {
+    Highs_setDoubleOptionValue(highs_, "time_limit", time_limit);
+}
+
+void orcs::HighsSolver::set_node_limit(double node_limit) {
+    double max_nodes = static_cast<double>(std::numeric_limits<HighsInt>::max());
+    Highs_setIntOptionValue(highs_, "mip_max_nodes", static_cast<HighsInt>(std::min(node_limit, max_nodes)));
+}
+
+orcs::MIPVar orcs::HighsSolver::add_var(double lb, double ub, VarType type) {
+    col_lower_.push_back(lb);
+    col_upper_.push_back(ub);
+    col_cost_.push_back(0.0);
+    col_type_.push_back(type);
+    col_start_.push_back(std::numeric_limits<double>::quiet_NaN());
+    return {static_cast<int>(col_type_.size()) - 1};
+}
+
+void orcs::HighsSolver::add_constr(const LinConstr& constr) {
+    double infinity = std::numeric_limits<double>::infinity();
+    row_lower_.push_back(constr.sense == Sense::LESS_EQUAL ? -infinity : constr.rhs);
+    row_upper_.push_back(constr.sense == Sense::GREATER_EQUAL ? infinity : constr.rhs);
+    row_index_.insert(row_index_.end(), constr.expr.indices().begin(), constr.expr.indices().end());
+    row_value_.insert(row_value_.end(), constr.expr.coefs().begin(), constr.expr.coefs().end());
+    row_start_.push_back(static_cast<int>(row_index_.size()));
+}
+
+void orcs::HighsSolver::set_objective(const LinExpr& expr) {
+    std::fill(col_cost_.begin(), col_cost_.end(), 0.0);
+    for (std::size_t k = 0; k < expr.indices().size(); ++k) {
+        col_cost_[expr.indices()[k]] += expr.coefs()[k];
+    }
+    offset_ = expr.constant();
+}
+
+void orcs::HighsSolver::set_upper_bound(MIPVar var, double ub) {
+    col_upper_[var.index] = ub;
+}
+
+void orcs::HighsSolver::set_type(MIPVar var, VarType type) {
+    col_type_[var.index] = type;
+}
+
+void orcs::HighsSolver::set_start(MIPVar var, double value) {
+    col_start_[var.index] = value;
+}
+
+void orcs::HighsSolver::set_callback(MIPCallback* callback, bool lazy_constraints) {
+    if (callback != nullptr && lazy_constraints) {
+        throw std::string("Lazy constraints are not supported by HiGHS.");
+    }
+
+    callback_ = callback;
+}
+
+bool orcs::HighsSolver::supports_lazy_constraints() const {
+    return false;
+}
+
+bool orcs::HighsSolver::supports_heuristic_solutions() const {
+    return false;
+}
+
+void orcs::HighsSolver::optimize() {
+
+    // Build the model (the matrix is given by rows)
+    HighsInt n_cols = static_cast<HighsInt>(col_type_.size());
+    HighsInt n_rows = static_cast<HighsInt>(row_lower_.size());
+    HighsInt n_nz = static_cast<HighsInt>(row_index_.size());
+
+    std::vector<HighsInt> a_start(row_start_.begin(), row_start_.end());
+    std::vector<HighsInt> a_index(row_index_.begin(), row_index_.end());
+
+    is_mip_ = std::any_of(col_type_.begin(), col_type_.end(), [](VarType type) {
+        return type != VarType::CONTINUOUS;
+    });
+
+    HighsInt load_status;
+    if (is_mip_) {
+        std::vector<HighsInt> integrality(n_cols, kHighsVarTypeContinuous);
+        for (HighsInt k = 0; k < n_cols; ++k) {
+            if (col_type_[k] != VarType::CONTINUOUS) {
+                integrality[k] = kHighsVarTypeInteger;
+            }
+        }
+
+        load_status = Highs_passMip(highs_, n_cols, n_rows, n_nz, kHighsMatrixFormatRowwise, kHighsObjSenseMinimize,
+                offset_, col_cost_.data(), col_lower_.data(), col_upper_.data(), row_lower_.data(),
+                row_upper_.data(), a_start.data(), a_index.data(), row_value_.data(), integrality.data());
+    } else {
+        load_status = Highs_passLp(highs_, n_cols, n_rows, n_nz, kHighsMatrixFormatRowwise, kHighsObjSenseMinimize,
+                offset_, col_cost_.data(), col_lower_.data(), col_upper_.data(), row_lower_.data(),
+                row_upper_.data(), a_start.data(), a_index.data(), row_value_.data());
+    }
+
+    if (load_status == kHighsStatusError) {
+        throw std::string("HiGHS failed to load the model.");
+    }
+
+    // Starting solution (values not given are set to the lower bounds)
+    bool has_start = std::any_of(col_start_.begin(), col_start_.end(), [](double value) {
+        return !std::isnan(value);
+    });
+
+    if (is_mip_ && has_start) {
+        std::vector<double> start(n_cols);
+        for (HighsInt k = 0; k < n_cols; ++k) {
+            start[k] = std::isnan(col_start_[k]) ? std::max(col_lower_[k], 0.0) : col_start_[k];
+        }
+
+        Highs_setSolution(highs_, start.data(), nullptr, nullptr, nullptr);
+    }
+
+    // Notify the callback of improving solutions
+    if (callback_ != nullptr) {
+        auto notify = [](int type, const char* message, const HighsCallbackDataOut* data_out,
+                         HighsCallbackDataIn* data_in, void* user_data) {
+            if (type == kHighsCallbackMipImprovingSolution) {
+                auto solution = static_cast<const double*>(Highs_getCallbackDataOutItem(data_out, "mip_solution"));
+                auto objective = static_cast<const double*>(
+                        Highs_getCallbackDataOutItem(data_out, "objective_function_value"));
+
+                if (solution != nullptr && objective != nullptr) {
+                    SolutionContext context(solution, *objective);
+                    static_cast<MIPCallback*>(user_data)->callback(context);
+                }
+            }
+        };
+
+        Highs_setCallback(highs_, notify, callback_);
+        Highs_startCallback(highs_, kHighsCallbackMipImprovingSolution);
+    } else {
+        Highs_stopCallback(highs_, kHighsCallbackMipImprovingSolution);
+    }
+
+    // Solve the model
+    auto start_time = std::chrono::steady_clock::now();
+    HighsInt run_status = Highs_run(highs_);
+    runtime_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    if (run_status == kHighsStatusError) {
+        throw std::string("HiGHS failed to solve the model.");
+    }
+
+    // Keep the solution
+    solved_ = true;
+    solution_.clear();
+    if (has_solution()) {
+        solution_.resize(n_cols);
+        Highs_getSolution(highs_, solution_.data(), nullptr, nullptr, nullptr);
+    }
+}
+
+void orcs::HighsSolver::reset() {
+    Highs_clearSolver(highs_);
+    solved_ = false;
+    runtime_ = 0.0;
+    solution_.clear();
+}
+
+orcs::MIPStatus orcs::HighsSolver::status() {
+    if (!solved_) {
+        return MIPStatus::UNKNOWN;
+    }
+
+    HighsInt model_status = Highs_getModelStatus(highs_);
+    if (model_status == kHighsModelStatusOptimal) {
+        return MIPStatus::OPTIMAL;
+    } else if (model_status == kHighsModelStatusInfeasible) {
+        return MIPStatus::INFEASIBLE;
+    } else if (model_status == kHighsModelStatusUnbounded) {
+        return MIPStatus::UNBOUNDED;
+    } else if (model_status == kHighsModelStatusUnboundedOrInfeasible) {
+        return MIPStatus::INF_OR_UNBD;
+    } else if (model_status == kHighsModelStatusTimeLimit || model_status == kHighsModelStatusIterationLimit
+            || model_status == kHighsModelStatusSolutionLimit || model_status == kHighsModelStatusInterrupt
+            || model_status == kHighsModelStatusObjectiveBound || model_status == kHighsModelStatusObjectiveTarget) {
+        return MIPStatus::LIMIT;
+    }
+
+    return MIPStatus::UNKNOWN;
+}
+
+bool orcs::HighsSolver::has_solution() {
+    HighsInt primal_status = kHighsSolutionStatusNone;
+    return solved_ && Highs_getIntInfoValue(highs_, "primal_solution_status", &primal_status) == kHighsStatusOk
+           && primal_status == kHighsSolutionStatusFeasible;
+}
+
+double orcs::HighsSolver::value(MIPVar var) {
+    return solution_[var.index];
+}
+
+double orcs::HighsSolver::objective() {
+    return Highs_getObjectiveValue(highs_);
+}
+
+double orcs::HighsSolver::gap() {
+    if (!solved_ || !is_mip_) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    double mip_gap = std::numeric_limits<double>::infinity();
+    if (has_solution()) {
+        Highs_getDoubleInfoValue(highs_, "mip_gap", &mip_gap);
+    }
+
+    return mip_gap;
+}
+
+double orcs::HighsSolver::node_count() {
+    std::int64_t nodes = -1;
+    if (solved_ && is_mip_) {
+        Highs_getInt64InfoValue(highs_, "mip_node_count", &nodes);
+    }
+
+    return static_cast<double>(nodes);
+}
+
+double orcs::HighsSolver::runtime() {
+    return runtime_;
+}
@@ -0,0 +1,96 @@
+#ifndef MANEUVER_SCHEDULING_MIP_SOLVER_HIGHS_H
+#define MANEUVER_SCHEDULING_MIP_SOLVER_HIGHS_H
+
+#include <vector>
+
+#include "mip_solver.h"
+
+
+namespace orcs {
+
+    /**
+     * MIP solver backed by HiGHS (open-source), through its C API (so it
+     * does not depend on the C++ ABI HiGHS was built with). The model is
+     * kept in compressed row storage and passed to HiGHS at once before each
+     * optimization. Lazy constraints and heuristic solutions injected by
+     * callbacks are not supported; callbacks are only notified of new
+     * incumbent solutions.
+     */
+    class HighsSolver : public MIPSolver {
+
+    public:
+
+        /**
+         * Constructor.
+         */
+        HighsSolver();
+
+        /**
+         * Destructor.
+         */
+        ~HighsSolver() override;
+
+        HighsSolver(const HighsSolver&) = delete;
+        HighsSolver& operator=(const HighsSolver&) = delete;
+
+        void set_verbose(bool verbose) override;
+        void set_threads(int threads) override;
+        void set_time_limit(double time_limit) override;
+        void set_node_limit(double node_limit) override;
+
+        MIPVar add_var(double lb, double ub, VarType type) override;
+        void add_constr(const LinConstr& constr) override;
+        void set_objective(const LinExpr& expr) override;
+
+        void set_upper_bound(MIPVar var, double ub) override;
+        void set_type(MIPVar var, VarType type) override;
+        void set_start(MIPVar var, double value) override;
+
+        void set_callback(MIPCallback* callback, bool lazy_constraints = false) override;
+        bool supports_lazy_constraints() const override;
+        bool supports_heuristic_solutions() const override;
+
+        void optimize() override;
+        void reset() override;
+
+        MIPStatus status() override;
+        bool has_solution() override;
+        double value(MIPVar var) override;
+        double objective() override;
+        double gap() override;
+        double node_count() override;
+        double runtime() override;
+
+    private:
+
+        // Instance of HiGHS (opaque handle of the C API)
+        void* highs_;
+        MIPCallback* callback_;
+
+        // Columns
+        std::vector<double> col_lower_;
+        std::vector<double> col_upper_;
+        std::vector<double> col_cost_;
+        std::vector<VarType> col_type_;
+        std::vector<double> col_start_;
+        double offset_;
+
+        // Rows (compressed row storage)
+        std::vector<double> row_lower_;
+        std::vector<double> row_upper_;
+        std::vector<int> row_start_;
+        std::vector<int> row_index_;
+        std::vector<double> row_value_;
+
+        // Results of the last optimization
+        bool is_mip_;
+        bool solved_;
+        double runtime_;
+        std::vector<double> solution_;
+
+    };
+
+}
+
+
+#endif
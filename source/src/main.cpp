@@ -2,25 +2,55 @@
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
 #include <string>
+#include <tuple>
+#include <vector>
 
 #include <cxxopts.hpp>
 #include <cxxtimer.hpp>
 #include <cxxproperties.hpp>
 
-#include <gurobi_c++.h>
-
 #include "problem/problem.h"
 #include "algorithm/algorithm.h"
 #include "util/common.h"
+#include "util/thread_pool.h"
+#include "util/trace_writer.h"
+
+#ifdef SCHD_WITH_GUROBI
+#include <gurobi_c++.h>
+#endif
 
+#ifdef SCHD_WITH_MIP
+#include "algorithm/mip/mip_solver.h"
 #include "algorithm/mip/mip_precedence.h"
 #include "algorithm/mip/mip_linear_ordering.h"
 #include "algorithm/mip/mip_arc_time_indexed.h"
+#endif
 
 #include "algorithm/heuristic/greedy.h"
 #include "algorithm/heuristic/neh.h"
 #include "algorithm/heuristic/ils.h"
+#include "algorithm/heuristic/grasp.h"
+
+
+/*
+ * Result of solving an instance with an algorithm.
+ */
+struct Result {
+    orcs::Schedule schedule;
+    double makespan;
+    bool feasible;
+    std::string feasibility_msg;
+    std::string status;
+    bool error;
+    std::string error_message;
+    double elapsed_time;
+    cxxproperties::Properties opt_output;
+};
 
 
 /*
@@ -29,6 +59,20 @@
 
 cxxopts::Options init_parser(int argc, char** argv);
 
+void check_algorithm(cxxopts::Options& options);
+
+cxxproperties::Properties init_input(cxxopts::Options& options);
+
+std::string instance_name(const std::string& filename);
+
+std::unique_ptr<orcs::TraceWriter> init_trace(cxxopts::Options& options);
+
+Result solve(const orcs::Problem& problem, const std::string& algorithm_name,
+        const cxxproperties::Properties& opt_input, orcs::TraceWriter* trace = nullptr,
+        const std::string& instance = "");
+
+int run_batch(cxxopts::Options& options);
+
 
 /*
  * Main function.
@@ -43,12 +87,17 @@ int main(int argc, char** argv) {
 
         // Show help message, if requested
         if (options.count("help") > 0) {
-            std::cout << options.help({"", "Printing", "General", "MIP formulations",
-                                       "Local search", "ILS"})
+            std::cout << options.help({"", "Printing", "General", "Batch", "MIP formulations",
+                                       "Local search", "Greedy and GRASP", "ILS"})
                       << std::endl;
             return EXIT_SUCCESS;
         }
 
+        // Solve the instances of a manifest file, if requested
+        if (options.count("batch") > 0) {
+            return run_batch(options);
+        }
+
         // Abort, if file not specified
         if (options.count("file") < 1) {
             throw std::string("Instance file not specified.");
@@ -62,126 +111,42 @@ int main(int argc, char** argv) {
             file.close();
         }
 
-        // Abort, if no algorithm is specified
-        if (options.count("algorithm") < 1) {
-            throw std::string("Algorithm not specified.");
+        // Convert the instance file into the binary format, if requested
+        if (options.count("convert") > 0) {
+            orcs::Problem problem(options["file"].as<std::string>());
+            problem.save(options["convert"].as<std::string>());
+            return EXIT_SUCCESS;
         }
 
-        // Abort, if algorithm is invalid
-        std::set<std::string> opt_algorithms = {"greedy", "neh", "ils", "mip-precedence",
-                                                "mip-linear-ordering", "mip-arc-time-indexed"};
-
-        if (opt_algorithms.count(options["algorithm"].as<std::string>()) < 1) {
-            throw std::string("Invalid algorithm.");
-        }
+        // Abort, if the algorithm is not specified or invalid
+        check_algorithm(options);
 
         // Load the problem
         orcs::Problem problem(options["file"].as<std::string>());
 
         // Algorithm parameters
-        cxxproperties::Properties opt_input;
-        opt_input.add("verbose", options["verbose"].as<bool>());
-        opt_input.add("threads", options["threads"].as<int>());
-        opt_input.add("seed", options["seed"].as<int>());
-        opt_input.add("time-limit", options["time-limit"].as<double>());
-        opt_input.add("iterations-limit", options["iterations-limit"].as<long>());
-
-        // Initialize the algorithm selected to solve the problem
-        orcs::Algorithm* algorithm = nullptr;
-        if (options["algorithm"].as<std::string>() == "greedy") {
-            algorithm = new orcs::Greedy();
-
-        } else if (options["algorithm"].as<std::string>() == "neh") {
-            algorithm = new orcs::NEH();
-
-        } else if (options["algorithm"].as<std::string>() == "ils") {
-            algorithm = new orcs::ILS();
-            opt_input.add("perturbation-passes-limit", options["perturbation-passes-limit"].as<long>());
-            opt_input.add("local-search-method", options["local-search-method"].as<std::string>());
-
-        } else if (options["algorithm"].as<std::string>() == "mip-precedence") {
-            algorithm = new orcs::MIPPrecedence();
-            opt_input.add("warm-start", options["warm-start"].as<bool>());
-            opt_input.add("solve-relaxation", true);
-
-        } else if (options["algorithm"].as<std::string>() == "mip-linear-ordering") {
-            algorithm = new orcs::MIPLinearOrdering();
-            opt_input.add("warm-start", options["warm-start"].as<bool>());
-            opt_input.add("solve-relaxation", true);
-
-        } else if (options["algorithm"].as<std::string>() == "mip-arc-time-indexed") {
-            algorithm = new orcs::MIPArcTimeIndexed();
-            opt_input.add("warm-start", options["warm-start"].as<bool>());
-            opt_input.add("solve-relaxation", true);
+        cxxproperties::Properties opt_input = init_input(options);
 
+        // Initial solution given by the user (checked before solving)
+        if (options.count("initial-solution") > 0) {
+            orcs::common::read_solution(options["initial-solution"].as<std::string>(), problem);
+            opt_input.add("initial-solution", options["initial-solution"].as<std::string>());
         }
 
-        // Properties to store optional output
-        cxxproperties::Properties opt_output;
-
-        // Create a timer
-        cxxtimer::Timer timer;
-
-        // Create an empty solution (used to store the result of the algorithm)
-        orcs::Schedule schedule = orcs::create_empty_schedule(problem.m);
-
-        bool error = false;
-        std::string error_message = "Unknown";
-
-        // Start the times
-        timer.start();
+        // Trace of the improvements of the best solution found (if requested)
+        auto trace = init_trace(options);
 
         // Solve the problem
-        try {
-
-            std::tie(schedule, std::ignore) = algorithm->solve(problem, &opt_input, &opt_output);
-
-        } catch (const GRBException& e) {
-            error = true;
-            error_message = orcs::common::format("Gurobi error %d: %s", e.getErrorCode(), e.getMessage().c_str());
-
-        } catch (const std::string& e) {
-            error_message = e;
-            error = true;
-
-        } catch (...) {
-            error_message = "Unknown";
-            error = true;
+        Result result = solve(problem, options["algorithm"].as<std::string>(), opt_input, trace.get(),
+                instance_name(options["file"].as<std::string>()));
+        const auto& schedule = result.schedule;
+        const auto& opt_output = result.opt_output;
+
+        // Save the solution found
+        if (options.count("save-solution") > 0 && result.feasible) {
+            orcs::common::write_solution(options["save-solution"].as<std::string>(), schedule);
         }
 
-        // Stop the time
-        timer.stop();
-
-        // Compute the makespan of the schedule
-        double makespan = problem.makespan(schedule);
-
-        // Check feasibility of the schedule
-        std::string feasibility_msg;
-        bool feasible = problem.is_feasible(schedule, &feasibility_msg);
-
-        // Check the status of the solution
-        std::string status = "UNKNOWN";
-        if (error) {
-            status = "ERROR";
-
-        } else {
-
-            // Check the status of the solution / optimization method
-            if (opt_output.contains("Status")) {
-                status = opt_output.get<std::string>("Status");
-
-            } else if (feasible) {
-                status = "SUBOPTIMAL";
-
-            } else {
-                status = "INFEASIBLE";
-
-            }
-        }
-
-        // Get elapsed time
-        double elapsed_time = timer.count<std::chrono::milliseconds>();
-
         // Show the output
         if (options.count("details") > 0 || options.count("solution") > 0) {
 
@@ -195,15 +160,15 @@ int main(int argc, char** argv) {
                         break;
 
                     case 1:
-                        std::cout << status << " "
-                                  << (feasible ? orcs::common::format("%.6lf", makespan) : "?")
+                        std::cout << result.status << " "
+                                  << (result.feasible ? orcs::common::format("%.6lf", result.makespan) : "?")
                                   << std::endl;
                         break;
 
                     case 2:
-                        std::cout << status << " "
-                                  << (feasible ? orcs::common::format("%.6lf", makespan) : "?") << " "
-                                  << orcs::common::format("%.4lf", elapsed_time / 1000.0) << " "
+                        std::cout << result.status << " "
+                                  << (result.feasible ? orcs::common::format("%.6lf", result.makespan) : "?") << " "
+                                  << orcs::common::format("%.4lf", result.elapsed_time / 1000.0) << " "
                                   << opt_output.get<std::string>("Iterations", "?") << " "
                                   << opt_output.get<std::string>("LP objective", "?") << " "
                                   << opt_output.get<std::string>("MIP gap", "?") << " "
@@ -215,18 +180,18 @@ int main(int argc, char** argv) {
                         std::cout << "======================================================================" << std::endl;
                         std::cout << "SUMMARY" << std::endl;
                         std::cout << "======================================================================" << std::endl;
-                        std::cout << "Makespan:         " << (feasible ? orcs::common::format("%.6lf", makespan) : "?") << std::endl;
-                        std::cout << "Status:           " << status << std::endl;
+                        std::cout << "Makespan:         " << (result.feasible ? orcs::common::format("%.6lf", result.makespan) : "?") << std::endl;
+                        std::cout << "Status:           " << result.status << std::endl;
 
-                        if (!feasible) {
-                            std::cout << "Infeasibility:    " << orcs::common::format("%s", feasibility_msg.c_str()) << std::endl;
+                        if (!result.feasible) {
+                            std::cout << "Infeasibility:    " << orcs::common::format("%s", result.feasibility_msg.c_str()) << std::endl;
                         }
 
-                        if (error) {
-                            std::cout << "Error details:    " << orcs::common::format(" - %s", error_message.c_str())<< std::endl;
+                        if (result.error) {
+                            std::cout << "Error details:    " << orcs::common::format(" - %s", result.error_message.c_str())<< std::endl;
                         }
 
-                        std::cout << "Elapsed time (s): " << orcs::common::format("%.4lf", elapsed_time / 1000.0) << std::endl << std::endl;
+                        std::cout << "Elapsed time (s): " << orcs::common::format("%.4lf", result.elapsed_time / 1000.0) << std::endl << std::endl;
                         std::cout << "Additional Information:" << std::endl;
                         if (opt_output.size() > 0) {
                             for (auto key : opt_output.get_keys()) {
@@ -250,12 +215,6 @@ int main(int argc, char** argv) {
 
         }
 
-        // Free resources
-        if (algorithm != nullptr) {
-            delete algorithm;
-            algorithm = nullptr;
-        }
-
     } catch (const std::string& e) {
         std::cerr << e << std::endl;
         std::cerr << "Type the following command for a correct usage." << std::endl;
@@ -286,6 +245,9 @@ cxxopts::Options init_parser(int argc, char** argv) {
              cxxopts::value<bool>(), "")
 
             ("f,file", "Path to the instance file with data of the problem to be solved.",
+             cxxopts::value<std::string>(), "FILE")
+
+            ("convert", "Convert the instance file into the binary format, write it to FILE and exit.",
              cxxopts::value<std::string>(), "FILE");
 
     options.add_options("Printing")
@@ -303,11 +265,23 @@ cxxopts::Options init_parser(int argc, char** argv) {
              cxxopts::value<int>()->default_value("1")->implicit_value("1"),"VALUE")
 
             ("s,solution", "Display the best solution found.",
-             cxxopts::value<bool>(), "");
+             cxxopts::value<bool>(), "")
+
+            ("save-solution", "Write the best solution found (if feasible) to FILE, in the same format it is "
+            "displayed.",
+             cxxopts::value<std::string>(), "FILE")
+
+            ("trace", "Write each improvement of the best solution found by the ILS-based heuristic (instance, seed, "
+            "time, iteration, worker and neighborhood of the last improving move) to FILE.",
+             cxxopts::value<std::string>(), "FILE")
+
+            ("trace-format", "Format of the file written by --trace (values: \"csv\", \"json\"). With \"json\", "
+            "each line of the file is a JSON object.",
+             cxxopts::value<std::string>()->default_value("csv"), "VALUE");
 
     options.add_options("General")
             ("a,algorithm", "Algorithm used to solve the problem (values: \"mip-precedence\", \"mip-linear-ordering\", "
-            "\"mip-arc-time-indexed\", \"greedy\", \"neh\", \"ils\").",
+            "\"mip-arc-time-indexed\", \"greedy\", \"neh\", \"ils\", \"grasp\").",
              cxxopts::value<std::string>(), "VALUE")
 
             ("time-limit", "Limit the total time expended (in seconds).",
@@ -316,6 +290,10 @@ cxxopts::Options init_parser(int argc, char** argv) {
             ("iterations-limit", "Limit the total number of iterations expended.",
              cxxopts::value<long>()->default_value(std::to_string(std::numeric_limits<long>::max())), "VALUE")
 
+            ("initial-solution", "Solution file (in the same format solutions are displayed) used as starting "
+            "point by the ILS-based heuristic and as warm start by the MIP formulations.",
+             cxxopts::value<std::string>(), "FILE")
+
             ("seed", "Set the seed used to initialize the random number generator.",
              cxxopts::value<int>()->default_value("0"), "VALUE")
 
@@ -323,19 +301,495 @@ cxxopts::Options init_parser(int argc, char** argv) {
             "(zero), all threads available are used.",
              cxxopts::value<int>()->default_value("1"), "VALUE");
 
+    options.add_options("Batch")
+            ("batch", "Solve all instances listed in the manifest FILE with the algorithm selected and write the "
+            "results in CSV format. Each line of the manifest has the path to an instance file followed by the seeds "
+            "used to solve it (if no seed is given, the value of --seed is used).",
+             cxxopts::value<std::string>(), "FILE")
+
+            ("batch-output", "File to write the results of --batch (by default, they are written to the standard "
+            "output).",
+             cxxopts::value<std::string>(), "FILE")
+
+            ("batch-threads", "Number of instances solved simultaneously by --batch. If set to 0 (zero), all threads "
+            "available are used.",
+             cxxopts::value<int>()->default_value("0"), "VALUE");
+
     options.add_options("MIP formulations")
-            ("warm-start", "If set, the solver will use the solution found by the greedy heuristic as starting solution.",
-             cxxopts::value<bool>(), "");
+            ("warm-start", "If set, the solver will use the solution found by the greedy heuristic as starting solution. "
+            "The precedence and arc-time-indexed formulations use the best solution of the heuristics selected by "
+            "--horizon-heuristic instead, and skip the warm start if the formulation cannot represent it.",
+             cxxopts::value<bool>(), "")
+
+            ("concurrent-ils", "If set, the ILS-based heuristic runs in a background thread during the MIP solve, "
+            "and its improved solutions are injected into the MIP solver (if it accepts heuristic solutions).",
+             cxxopts::value<bool>(), "")
+
+            ("lazy-triangles", "If set, the transitivity constraints of the linear ordering formulation are added "
+            "lazily, only when violated by an integer solution or by the relaxation of a node (if the MIP solver "
+            "supports lazy constraints).",
+             cxxopts::value<bool>(), "")
+
+            ("horizon-heuristic", "Heuristic used to bound the makespan, which sets the time horizon and the latest "
+            "start times of the switches in the precedence and arc-time-indexed formulations (values: \"greedy\", "
+            "\"neh\", \"ils\"). The best solution of the heuristics up to the one selected is used.",
+             cxxopts::value<std::string>()->default_value("neh"), "VALUE")
+
+            ("horizon-ils-iterations", "Iterations limit of the ILS-based heuristic when it is used to bound the "
+            "makespan.",
+             cxxopts::value<long>()->default_value("100"), "VALUE");
+
+#ifdef SCHD_WITH_MIP
+    std::string mip_solvers;
+    for (const auto& name : orcs::MIPSolver::available()) {
+        mip_solvers += (mip_solvers.empty() ? "\"" : ", \"") + name + "\"";
+    }
+
+    options.add_options("MIP formulations")
+            ("mip-solver", "Solver used to solve the MIP formulations (values: " + mip_solvers + ").",
+             cxxopts::value<std::string>()->default_value(orcs::MIPSolver::available().front()), "VALUE");
+#endif
 
     options.add_options("Local search")
             ("local-search-method", "Method used to perform local search. Available values are \"vnd\" and \"rvnd\".",
-             cxxopts::value<std::string>()->default_value("vnd"), "VALUE");
+             cxxopts::value<std::string>()->default_value("vnd"), "VALUE")
+
+            ("local-search-approach", "Approach used to explore the neighborhoods. Available values are \"best\" (best "
+            "improvement), \"first\" (first improvement, with the moves in a random order) and \"sampled\" (best of a "
+            "random sample of the moves).",
+             cxxopts::value<std::string>()->default_value("best"), "VALUE")
+
+            ("neighborhood-sample-size", "Number of moves evaluated in each neighborhood by the \"sampled\" approach.",
+             cxxopts::value<long>()->default_value("1000"), "VALUE")
+
+            ("neighborhood-threads", "Number of threads used to evaluate the neighbors of a solution. The moves are "
+            "split into blocks (by team or pair of teams) evaluated in parallel, and ties are broken by the order of the "
+            "moves. If set to 0 (zero), all threads available are used.",
+             cxxopts::value<int>()->default_value("1"), "VALUE")
+
+            ("evaluation-cache", "Maximum number of schedule evaluations kept in a cache (rounded up to a power of "
+            "two). Schedules are identified by a hash of their sequences. If set to 0 (zero), no cache is used.",
+             cxxopts::value<long>()->default_value("0"), "VALUE");
+
+    options.add_options("Greedy and GRASP")
+            ("alpha", "Greediness of the randomized choices of the greedy heuristic: a switch and a team are chosen at "
+            "random among those whose criterion is within the fraction alpha of the range of the criteria (0 means "
+            "the deterministic greedy heuristic). By default, the greedy heuristic is deterministic and GRASP uses 0.1.",
+             cxxopts::value<double>(), "VALUE")
+
+            ("grasp-starts", "Number of solutions built by the randomized greedy heuristic in GRASP.",
+             cxxopts::value<long>()->default_value("100"), "VALUE")
+
+            ("grasp-elite", "Number of the best distinct solutions built in GRASP that are improved by local search.",
+             cxxopts::value<long>()->default_value("4"), "VALUE");
 
     options.add_options("ILS")
             ("perturbation-passes-limit", "The highest value of perturbation strength. If no improvement is found after "
-            "a perturbation with this strength, the VNS/ILS stops.",
-             cxxopts::value<long>()->default_value("5"), "VALUE");
+            "a perturbation with this strength, the VNS/ILS stops (or restarts, see --restarts-limit).",
+             cxxopts::value<long>()->default_value("5"), "VALUE")
+
+            ("acceptance", "Criterion to accept the solution found by the local search from the perturbed solution as the "
+            "next solution to perturb (values: \"better\", \"random-walk\", \"annealing\").",
+             cxxopts::value<std::string>()->default_value("better"), "VALUE")
+
+            ("acceptance-temperature", "Initial temperature of the \"annealing\" acceptance criterion, as a fraction of "
+            "the makespan of the first local optimum.",
+             cxxopts::value<double>()->default_value("0.01"), "VALUE")
+
+            ("acceptance-cooling", "Factor by which the temperature of the \"annealing\" acceptance criterion is "
+            "multiplied at each iteration.",
+             cxxopts::value<double>()->default_value("0.99"), "VALUE")
+
+            ("restart-policy", "Solution from which the ILS restarts (values: \"best\", \"random\"). With \"random\", "
+            "a solution is built by the randomized greedy heuristic (see --alpha).",
+             cxxopts::value<std::string>()->default_value("random"), "VALUE")
+
+            ("restarts-limit", "Maximum number of restarts of each worker of the ILS. A restart happens when no "
+            "improvement is found with the highest perturbation strength.",
+             cxxopts::value<long>()->default_value("0"), "VALUE");
 
     options.parse(argc, argv);
     return options;
 }
+
+void check_algorithm(cxxopts::Options& options) {
+
+    // Abort, if no algorithm is specified
+    if (options.count("algorithm") < 1) {
+        throw std::string("Algorithm not specified.");
+    }
+
+    // Abort, if algorithm is invalid
+    std::set<std::string> opt_algorithms = {"greedy", "neh", "ils", "grasp", "mip-precedence",
+                                            "mip-linear-ordering", "mip-arc-time-indexed"};
+
+    if (opt_algorithms.count(options["algorithm"].as<std::string>()) < 1) {
+        throw std::string("Invalid algorithm.");
+    }
+
+#ifndef SCHD_WITH_MIP
+    // Abort, if a MIP formulation is requested but the solver is not available
+    if (options["algorithm"].as<std::string>().compare(0, 4, "mip-") == 0) {
+        throw std::string("MIP formulations are not available (built without a MIP solver).");
+    }
+#endif
+}
+
+cxxproperties::Properties init_input(cxxopts::Options& options) {
+
+    // General parameters
+    cxxproperties::Properties opt_input;
+    opt_input.add("verbose", options["verbose"].as<bool>());
+    opt_input.add("threads", options["threads"].as<int>());
+    opt_input.add("seed", options["seed"].as<int>());
+    opt_input.add("time-limit", options["time-limit"].as<double>());
+    opt_input.add("iterations-limit", options["iterations-limit"].as<long>());
+
+    // Parameters of the algorithm selected to solve the problem
+    if (options["algorithm"].as<std::string>() == "ils") {
+        opt_input.add("perturbation-passes-limit", options["perturbation-passes-limit"].as<long>());
+        opt_input.add("local-search-method", options["local-search-method"].as<std::string>());
+        opt_input.add("neighborhood-threads", options["neighborhood-threads"].as<int>());
+        opt_input.add("evaluation-cache", options["evaluation-cache"].as<long>());
+        opt_input.add("local-search-approach", options["local-search-approach"].as<std::string>());
+        opt_input.add("neighborhood-sample-size", options["neighborhood-sample-size"].as<long>());
+        opt_input.add("acceptance", options["acceptance"].as<std::string>());
+        opt_input.add("acceptance-temperature", options["acceptance-temperature"].as<double>());
+        opt_input.add("acceptance-cooling", options["acceptance-cooling"].as<double>());
+        opt_input.add("restart-policy", options["restart-policy"].as<std::string>());
+        opt_input.add("restarts-limit", options["restarts-limit"].as<long>());
+        if (options.count("alpha") > 0) {
+            opt_input.add("alpha", options["alpha"].as<double>());
+        }
+
+    } else if (options["algorithm"].as<std::string>() == "grasp") {
+        opt_input.add("grasp-starts", options["grasp-starts"].as<long>());
+        opt_input.add("grasp-elite", options["grasp-elite"].as<long>());
+        opt_input.add("local-search-method", options["local-search-method"].as<std::string>());
+        opt_input.add("local-search-approach", options["local-search-approach"].as<std::string>());
+        opt_input.add("neighborhood-sample-size", options["neighborhood-sample-size"].as<long>());
+        if (options.count("alpha") > 0) {
+            opt_input.add("alpha", options["alpha"].as<double>());
+        }
+
+    } else if (options["algorithm"].as<std::string>() == "greedy") {
+        if (options.count("alpha") > 0) {
+            opt_input.add("alpha", options["alpha"].as<double>());
+        }
+
+    }
+#ifdef SCHD_WITH_MIP
+    else if (options["algorithm"].as<std::string>() == "mip-precedence") {
+        opt_input.add("warm-start", options["warm-start"].as<bool>());
+        opt_input.add("concurrent-ils", options["concurrent-ils"].as<bool>());
+        opt_input.add("mip-solver", options["mip-solver"].as<std::string>());
+        opt_input.add("horizon-heuristic", options["horizon-heuristic"].as<std::string>());
+        opt_input.add("horizon-ils-iterations", options["horizon-ils-iterations"].as<long>());
+        opt_input.add("solve-relaxation", true);
+
+    } else if (options["algorithm"].as<std::string>() == "mip-linear-ordering") {
+        opt_input.add("warm-start", options["warm-start"].as<bool>());
+        opt_input.add("concurrent-ils", options["concurrent-ils"].as<bool>());
+        opt_input.add("mip-solver", options["mip-solver"].as<std::string>());
+        opt_input.add("lazy-triangles", options["lazy-triangles"].as<bool>());
+        opt_input.add("solve-relaxation", true);
+
+    } else if (options["algorithm"].as<std::string>() == "mip-arc-time-indexed") {
+        opt_input.add("warm-start", options["warm-start"].as<bool>());
+        opt_input.add("concurrent-ils", options["concurrent-ils"].as<bool>());
+        opt_input.add("mip-solver", options["mip-solver"].as<std::string>());
+        opt_input.add("horizon-heuristic", options["horizon-heuristic"].as<std::string>());
+        opt_input.add("horizon-ils-iterations", options["horizon-ils-iterations"].as<long>());
+        opt_input.add("solve-relaxation", true);
+
+    }
+#endif
+
+    return opt_input;
+}
+
+std::string instance_name(const std::string& filename) {
+
+    // The name of the instance is the name of the file without directories
+    // and extension
+    auto name = filename.substr(filename.find_last_of("/\\") + 1);
+    return name.substr(0, name.find_last_of('.'));
+}
+
+std::unique_ptr<orcs::TraceWriter> init_trace(cxxopts::Options& options) {
+
+    if (options.count("trace") < 1) {
+        return nullptr;
+    }
+
+    // Abort, if the algorithm does not support the trace
+    if (options["algorithm"].as<std::string>() != "ils") {
+        throw std::string("Option --trace is only available for the ILS-based heuristic.");
+    }
+
+    return std::make_unique<orcs::TraceWriter>(options["trace"].as<std::string>(),
+                                               options["trace-format"].as<std::string>());
+}
+
+Result solve(const orcs::Problem& problem, const std::string& algorithm_name,
+        const cxxproperties::Properties& opt_input, orcs::TraceWriter* trace, const std::string& instance) {
+
+    // Initialize the algorithm selected to solve the problem
+    std::unique_ptr<orcs::Algorithm> algorithm;
+    if (algorithm_name == "greedy") {
+        algorithm = std::make_unique<orcs::Greedy>();
+
+    } else if (algorithm_name == "neh") {
+        algorithm = std::make_unique<orcs::NEH>();
+
+    } else if (algorithm_name == "ils") {
+        auto ils = std::make_unique<orcs::ILS>();
+        ils->set_trace_writer(trace, instance);
+        algorithm = std::move(ils);
+
+    } else if (algorithm_name == "grasp") {
+        algorithm = std::make_unique<orcs::GRASP>();
+
+    }
+#ifdef SCHD_WITH_MIP
+    else if (algorithm_name == "mip-precedence") {
+        algorithm = std::make_unique<orcs::MIPPrecedence>();
+
+    } else if (algorithm_name == "mip-linear-ordering") {
+        algorithm = std::make_unique<orcs::MIPLinearOrdering>();
+
+    } else if (algorithm_name == "mip-arc-time-indexed") {
+        algorithm = std::make_unique<orcs::MIPArcTimeIndexed>();
+
+    }
+#endif
+
+    Result result;
+
+    // Create a timer
+    cxxtimer::Timer timer;
+
+    // Create an empty solution (used to store the result of the algorithm)
+    result.schedule = orcs::create_empty_schedule(problem.m);
+
+    result.error = false;
+    result.error_message = "Unknown";
+
+    // Start the times
+    timer.start();
+
+    // Solve the problem
+    try {
+
+        std::tie(result.schedule, std::ignore) = algorithm->solve(problem, &opt_input, &result.opt_output);
+
+    }
+#ifdef SCHD_WITH_GUROBI
+    catch (const GRBException& e) {
+        result.error = true;
+        result.error_message = orcs::common::format("Gurobi error %d: %s", e.getErrorCode(), e.getMessage().c_str());
+
+    }
+#endif
+    catch (const std::string& e) {
+        result.error_message = e;
+        result.error = true;
+
+    } catch (...) {
+        result.error_message = "Unknown";
+        result.error = true;
+    }
+
+    // Stop the time
+    timer.stop();
+
+    // Compute the makespan of the schedule
+    result.makespan = problem.makespan(result.schedule);
+
+    // Check feasibility of the schedule
+    result.feasible = problem.is_feasible(result.schedule, &result.feasibility_msg);
+
+    // Check the status of the solution
+    result.status = "UNKNOWN";
+    if (result.error) {
+        result.status = "ERROR";
+
+    } else {
+
+        // Check the status of the solution / optimization method
+        if (result.opt_output.contains("Status")) {
+            result.status = result.opt_output.get<std::string>("Status");
+
+        } else if (result.feasible) {
+            result.status = "SUBOPTIMAL";
+
+        } else {
+            result.status = "INFEASIBLE";
+
+        }
+    }
+
+    // Get elapsed time
+    result.elapsed_time = timer.count<std::chrono::milliseconds>();
+
+    return result;
+}
+
+int run_batch(cxxopts::Options& options) {
+
+    // Abort, if options that refer to a single instance are given
+    if (options.count("file") > 0 || options.count("initial-solution") > 0 || options.count("save-solution") > 0) {
+        throw std::string("Options --file, --initial-solution and --save-solution cannot be used with --batch.");
+    }
+
+    // Abort, if the algorithm is not specified or invalid
+    check_algorithm(options);
+
+    // Instances of the manifest. Each instance is loaded by the first job that
+    // needs it and released after its last job.
+    struct Instance {
+        std::string name;
+        std::string filename;
+        std::unique_ptr<orcs::Problem> problem;
+        std::string error;
+        int pending = 0;
+        std::mutex mutex;
+    };
+
+    std::vector< std::unique_ptr<Instance> > instances;
+    std::vector< std::tuple<std::size_t, int> > jobs;
+
+    // Read the manifest: each line has the path to an instance file followed
+    // by the seeds used to solve it (if none is given, --seed is used)
+    std::ifstream manifest(options["batch"].as<std::string>());
+    if (!manifest.is_open()) {
+        throw std::string("File \"" + options["batch"].as<std::string>() + "\" cannot be opened.");
+    }
+
+    std::string line;
+    while (std::getline(manifest, line)) {
+
+        // Skip comments and empty lines
+        std::istringstream stream(line.substr(0, line.find('#')));
+        std::string filename;
+        if (!(stream >> filename)) {
+            continue;
+        }
+
+        std::vector<int> seeds;
+        int seed;
+        while (stream >> seed) {
+            seeds.push_back(seed);
+        }
+
+        if (!stream.eof()) {
+            throw std::string("Invalid seed in manifest file: \"" + line + "\".");
+        }
+
+        if (seeds.empty()) {
+            seeds.push_back(options["seed"].as<int>());
+        }
+
+        auto instance = std::make_unique<Instance>();
+        instance->filename = filename;
+        instance->name = instance_name(filename);
+        instance->pending = static_cast<int>(seeds.size());
+
+        for (auto s : seeds) {
+            jobs.emplace_back(instances.size(), s);
+        }
+
+        instances.push_back(std::move(instance));
+    }
+
+    // Output stream of the results
+    std::ofstream file;
+    std::ostream* output = &std::cout;
+    if (options.count("batch-output") > 0) {
+        file.open(options["batch-output"].as<std::string>());
+        if (!file.is_open()) {
+            throw std::string("File \"" + options["batch-output"].as<std::string>() + "\" cannot be opened.");
+        }
+        output = &file;
+    }
+
+    std::mutex output_mutex;
+
+    // Trace of the improvements of all jobs (if requested)
+    auto trace = init_trace(options);
+
+    *output << "INSTANCE,ALGORITHM,SEED,STATUS,OBJECTIVE,TIME.SEC,ITERATIONS,RELAXATION,OPT.GAP" << std::endl;
+
+    // Algorithm parameters (the progress of simultaneous jobs is not shown)
+    auto algorithm = options["algorithm"].as<std::string>();
+    cxxproperties::Properties opt_input = init_input(options);
+    opt_input.add("verbose", false);
+
+    // Solve the jobs. Each thread of the pool takes the next job as soon as it
+    // finishes the previous one.
+    orcs::ThreadPool pool(options["batch-threads"].as<int>());
+    pool.run(static_cast<int>(jobs.size()), [&](int k) {
+        auto& instance = *instances[std::get<0>(jobs[k])];
+        int seed = std::get<1>(jobs[k]);
+
+        // Load the instance (if not loaded yet)
+        {
+            std::lock_guard<std::mutex> lock(instance.mutex);
+            if (instance.problem == nullptr && instance.error.empty()) {
+                if (!std::ifstream(instance.filename).is_open()) {
+                    instance.error = "File \"" + instance.filename + "\" cannot be opened.";
+                } else {
+                    try {
+                        instance.problem = std::make_unique<orcs::Problem>(instance.filename);
+                    } catch (const std::string& e) {
+                        instance.error = e;
+                    } catch (...) {
+                        instance.error = "Unknown";
+                    }
+                }
+            }
+        }
+
+        // Solve the instance
+        std::string row;
+        std::string error;
+        if (instance.problem != nullptr) {
+            cxxproperties::Properties opt_job = opt_input;
+            opt_job.add("seed", seed);
+
+            Result result = solve(*instance.problem, algorithm, opt_job, trace.get(), instance.name);
+            row = orcs::common::format("%s,%s,%d,%s,%s,%.4lf,%s,%s,%s",
+                    instance.name.c_str(), algorithm.c_str(), seed, result.status.c_str(),
+                    (result.feasible ? orcs::common::format("%.6lf", result.makespan).c_str() : ""),
+                    result.elapsed_time / 1000.0,
+                    result.opt_output.get<std::string>("Iterations", "").c_str(),
+                    result.opt_output.get<std::string>("LP objective", "").c_str(),
+                    result.opt_output.get<std::string>("MIP gap", "").c_str());
+
+            if (result.error) {
+                error = result.error_message;
+            }
+
+        } else {
+            row = orcs::common::format("%s,%s,%d,ERROR,,,,,", instance.name.c_str(), algorithm.c_str(), seed);
+            error = instance.error;
+        }
+
+        // Release the instance after its last job
+        {
+            std::lock_guard<std::mutex> lock(instance.mutex);
+            if (--instance.pending == 0) {
+                instance.problem.reset();
+            }
+        }
+
+        // Write the results
+        std::lock_guard<std::mutex> lock(output_mutex);
+        *output << row << std::endl;
+        if (!error.empty()) {
+            std::cerr << instance.name << " (seed " << seed << "): " << error << std::endl;
+        }
+    });
+
+    return EXIT_SUCCESS;
+}
@@ -1,47 +1,72 @@
 #include "direct_swap.h"
 
 
-std::tuple< orcs::Schedule, std::tuple<double, double> > orcs::DirectSwap::best(const Problem& problem,
-        const std::tuple< Schedule, std::tuple<double, double> >& entry) {
-
-    // Get the start solution
-    const auto& [start_schedule, start_eval] = entry;
+int orcs::DirectSwap::blocks(const Problem& problem) const {
+    return problem.m * problem.m;
+}
 
-    // Keep the best neighbor
-    auto [best_schedule, best_eval] = entry;
-
-    // Evaluate all neighbors
-    for (int l1 = 1; l1 <= problem.m; ++l1) {
-        if (start_schedule[l1].size() > 0) {
-            for (int l2 = l1 + 1; l2 <= problem.m; ++l2) {
-                if (start_schedule[l2].size() > 0) {
-                    for (int idx1 = 0; idx1 < start_schedule[l1].size(); ++idx1) {
-                        for (int idx2 = 0; idx2 < start_schedule[l2].size(); ++idx2) {
-
-                            // Build a neighbor
-                            Schedule neighbor_schedule = start_schedule;
-                            int i_1 = neighbor_schedule[l1][idx1];
-                            int i_2 = neighbor_schedule[l2][idx2];
-                            neighbor_schedule[l1][idx1] = i_2;
-                            neighbor_schedule[l2][idx2] = i_1;
-
-                            // Evaluate the neighbor
-                            auto neighbor_eval = orcs::common::evaluate(problem, neighbor_schedule);
-
-                            // Update the best neighbor
-                            if (orcs::common::less(neighbor_eval, best_eval)) {
-                                best_schedule = std::move(neighbor_schedule);
-                                best_eval = std::move(neighbor_eval);
-                            }
-                        }
-                    }
+void orcs::DirectSwap::moves(const Problem& problem, const Schedule& schedule, int block,
+        const std::function<bool(const Move&)>& visit) {
+
+    // Enumerate the moves between teams l1 and l2 (with l1 < l2)
+    int l1 = 1 + block / problem.m;
+    int l2 = 1 + block % problem.m;
+    if (l1 < l2 && schedule[l1].size() > 0 && schedule[l2].size() > 0) {
+        for (int idx1 = 0; idx1 < schedule[l1].size(); ++idx1) {
+            for (int idx2 = 0; idx2 < schedule[l2].size(); ++idx2) {
+
+                // Describe the move
+                Move move;
+                move.l1 = l1;
+                move.idx1 = idx1;
+                move.target1 = idx2;
+                move.l2 = l2;
+                move.idx2 = idx2;
+                move.target2 = idx1;
+                move.from1 = idx1;
+                move.from2 = idx2;
+
+                if (!visit(move)) {
+                    return;
                 }
             }
         }
     }
+}
+
+long orcs::DirectSwap::count(const Problem& problem, const Schedule& schedule, int block) const {
+    int l1 = 1 + block / problem.m;
+    int l2 = 1 + block % problem.m;
+    return l1 < l2 ? static_cast<long>(schedule[l1].size()) * schedule[l2].size() : 0L;
+}
+
+orcs::Move orcs::DirectSwap::move_at(const Problem& problem, const Schedule& schedule, int block, long index) const {
+
+    // Decode the positions of the move
+    int l1 = 1 + block / problem.m;
+    int l2 = 1 + block % problem.m;
+    int idx1 = index / schedule[l2].size();
+    int idx2 = index % schedule[l2].size();
+
+    // Describe the move
+    Move move;
+    move.l1 = l1;
+    move.idx1 = idx1;
+    move.target1 = idx2;
+    move.l2 = l2;
+    move.idx2 = idx2;
+    move.target2 = idx1;
+    move.from1 = idx1;
+    move.from2 = idx2;
+    return move;
+}
+
+void orcs::DirectSwap::apply(Schedule& schedule, const Move& move) const {
+    std::swap(schedule[move.l1][move.idx1], schedule[move.l2][move.idx2]);
+}
 
-    // Return the best neighbor
-    return {best_schedule, best_eval};
+void orcs::DirectSwap::undo(Schedule& schedule, const Move& move) const {
+    std::swap(schedule[move.l1][move.idx1], schedule[move.l2][move.idx2]);
 }
 
 std::tuple< orcs::Schedule, std::tuple<double, double> > orcs::DirectSwap::any(const Problem& problem,
@@ -1,43 +1,67 @@
 #include "exchange.h"
 
 
-std::tuple< orcs::Schedule, std::tuple<double, double> > orcs::Exchange::best(const Problem& problem,
-        const std::tuple< Schedule, std::tuple<double, double> >& entry) {
+int orcs::Exchange::blocks(const Problem& problem) const {
+    return problem.m + 1;
+}
 
-    // Get the start solution
-    const auto& [start_schedule, start_eval] = entry;
+void orcs::Exchange::moves(const Problem& problem, const Schedule& schedule, int block,
+        const std::function<bool(const Move&)>& visit) {
+
+    // Enumerate the moves of team l
+    int l = block;
+    if (schedule[l].size() >= 2) {
+        for (int idx1 = 0; idx1 < schedule[l].size() - 1; ++idx1) {
+            for (int idx2 = idx1 + 1; idx2 < schedule[l].size(); ++idx2) {
 
-    // Keep the best neighbor
-    auto [best_schedule, best_eval] = entry;
-
-    // Evaluate all neighbors
-    for (int l = 0; l <= problem.m; ++l) {
-        if (start_schedule[l].size() >= 2) {
-            for (int idx1 = 0; idx1 < start_schedule[l].size() - 1; ++idx1) {
-                for (int idx2 = idx1 + 1; idx2 < start_schedule[l].size(); ++idx2) {
-
-                    // Build a neighbor
-                    Schedule neighbor_schedule = start_schedule;
-                    int i_1 = neighbor_schedule[l][idx1];
-                    int i_2 = neighbor_schedule[l][idx2];
-                    neighbor_schedule[l][idx1] = i_2;
-                    neighbor_schedule[l][idx2] = i_1;
-
-                    // Evaluate the neighbor
-                    auto neighbor_eval = orcs::common::evaluate(problem, neighbor_schedule);
-
-                    // Update the best neighbor
-                    if (orcs::common::less(neighbor_eval, best_eval)) {
-                        best_schedule = std::move(neighbor_schedule);
-                        best_eval = std::move(neighbor_eval);
-                    }
+                // Describe the move
+                Move move;
+                move.l1 = l;
+                move.idx1 = idx1;
+                move.target1 = idx2;
+                move.from1 = idx1;
+
+                if (!visit(move)) {
+                    return;
                 }
             }
         }
     }
+}
+
+long orcs::Exchange::count(const Problem& problem, const Schedule& schedule, int block) const {
+    long size = schedule[block].size();
+    return size * std::max(0L, size - 1) / 2;
+}
+
+orcs::Move orcs::Exchange::move_at(const Problem& problem, const Schedule& schedule, int block, long index) const {
+
+    // Decode the positions of the move (pairs idx1 < idx2 in lexicographic
+    // order)
+    long size = schedule[block].size();
+    int idx1 = 0;
+    while (index >= size - 1 - idx1) {
+        index -= size - 1 - idx1;
+        ++idx1;
+    }
+
+    int idx2 = idx1 + 1 + index;
+
+    // Describe the move
+    Move move;
+    move.l1 = block;
+    move.idx1 = idx1;
+    move.target1 = idx2;
+    move.from1 = idx1;
+    return move;
+}
+
+void orcs::Exchange::apply(Schedule& schedule, const Move& move) const {
+    std::swap(schedule[move.l1][move.idx1], schedule[move.l1][move.target1]);
+}
 
-    // Return the best neighbor
-    return {best_schedule, best_eval};
+void orcs::Exchange::undo(Schedule& schedule, const Move& move) const {
+    std::swap(schedule[move.l1][move.idx1], schedule[move.l1][move.target1]);
 }
 
 std::tuple< orcs::Schedule, std::tuple<double, double> > orcs::Exchange::any(const Problem& problem,
@@ -0,0 +1,237 @@
+#include "neighborhood.h"
+
+#include <numeric>
+
+
+std::tuple< orcs::Schedule, std::tuple<double, double> > orcs::Neighborhood::best(const Problem& problem,
+        const std::tuple< Schedule, std::tuple<double, double> >& entry) {
+
+    // Explore the neighborhood by the approach selected
+    if (approach_ == Approach::FIRST) {
+        return first(problem, entry);
+    } else if (approach_ == Approach::SAMPLED) {
+        return sampled(problem, entry);
+    }
+
+    return exhaustive(problem, entry);
+}
+
+std::tuple< orcs::Schedule, std::tuple<double, double> > orcs::Neighborhood::exhaustive(const Problem& problem,
+        const std::tuple< Schedule, std::tuple<double, double> >& entry) {
+
+    // Get the start solution
+    const auto& [start_schedule, start_eval] = entry;
+
+    // Keep the best neighbor
+    auto [best_schedule, best_eval] = entry;
+    Move best_move;
+    bool improved = false;
+
+    // Evaluate the neighbors incrementally from the start solution
+    IncrementalEvaluator evaluator(problem, cache_);
+    evaluator.reset(start_schedule);
+
+    if (pool_ == nullptr || pool_->size() <= 1) {
+
+        // Working schedule, modified in place by each move
+        Schedule schedule = start_schedule;
+
+        // Evaluate all neighbors
+        auto visit = [&](const Move& move) {
+
+            // Build and evaluate the neighbor
+            apply(schedule, move);
+            auto neighbor_eval = evaluator.evaluate(schedule, move.l1, move.from1, move.l2, move.from2);
+            undo(schedule, move);
+
+            // Update the best neighbor
+            if (orcs::common::less(neighbor_eval, best_eval)) {
+                best_move = move;
+                best_eval = neighbor_eval;
+                improved = true;
+            }
+
+            return true;
+        };
+
+        for (int block = 0; block < blocks(problem); ++block) {
+            moves(problem, start_schedule, block, visit);
+        }
+
+    } else {
+
+        // Best neighbor of each block
+        int count = blocks(problem);
+        std::vector<Move> block_move(count);
+        std::vector< std::tuple<double, double> > block_eval(count, start_eval);
+        std::vector<char> block_improved(count, 0);
+
+        // Evaluate the blocks in parallel. Each task has its own working
+        // schedule and a copy of the evaluator.
+        pool_->run(count, [&](int block) {
+            IncrementalEvaluator block_evaluator(evaluator);
+            Schedule schedule = start_schedule;
+
+            moves(problem, start_schedule, block, [&](const Move& move) {
+
+                // Build and evaluate the neighbor
+                apply(schedule, move);
+                auto neighbor_eval = block_evaluator.evaluate(schedule, move.l1, move.from1, move.l2, move.from2);
+                undo(schedule, move);
+
+                // Update the best neighbor of the block
+                if (orcs::common::less(neighbor_eval, block_eval[block])) {
+                    block_move[block] = move;
+                    block_eval[block] = neighbor_eval;
+                    block_improved[block] = 1;
+                }
+
+                return true;
+            });
+        });
+
+        // Reduce the best neighbors of the blocks in order
+        for (int block = 0; block < count; ++block) {
+            if (block_improved[block] && orcs::common::less(block_eval[block], best_eval)) {
+                best_move = block_move[block];
+                best_eval = block_eval[block];
+                improved = true;
+            }
+        }
+    }
+
+    // Materialize the best neighbor
+    if (improved) {
+        apply(best_schedule, best_move);
+    }
+
+    // Return the best neighbor
+    return {best_schedule, best_eval};
+}
+
+void orcs::Neighborhood::set_thread_pool(ThreadPool* pool) {
+    pool_ = pool;
+}
+
+void orcs::Neighborhood::set_evaluation_cache(EvaluationCache* cache) {
+    cache_ = cache;
+}
+
+void orcs::Neighborhood::set_approach(Approach approach, std::mt19937* generator, long sample_size) {
+    approach_ = approach;
+    generator_ = generator;
+    sample_size_ = sample_size;
+}
+
+std::tuple< orcs::Schedule, std::tuple<double, double> > orcs::Neighborhood::first(const Problem& problem,
+        const std::tuple< Schedule, std::tuple<double, double> >& entry) {
+
+    // Get the start solution
+    const auto& [start_schedule, start_eval] = entry;
+    std::mt19937& generator = (generator_ != nullptr ? *generator_ : own_generator_);
+
+    // Evaluate the neighbors incrementally from the start solution
+    IncrementalEvaluator evaluator(problem, cache_);
+    evaluator.reset(start_schedule);
+
+    // Working schedule, modified in place by each move
+    Schedule schedule = start_schedule;
+
+    // Visit the blocks in a random order
+    std::vector<int> order(blocks(problem));
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), generator);
+
+    for (auto block : order) {
+        long size = count(problem, schedule, block);
+        if (size == 0) {
+            continue;
+        }
+
+        // Visit the moves of the block from a random position with a random
+        // step coprime to the number of moves (so each move is visited once)
+        std::uniform_int_distribution<long> distribution(0, size - 1);
+        long index = distribution(generator);
+        long step = 1 + distribution(generator);
+        while (std::gcd(step, size) != 1) {
+            step = 1 + distribution(generator);
+        }
+
+        for (long k = 0; k < size; ++k, index = (index + step) % size) {
+
+            // Build and evaluate the neighbor
+            Move move = move_at(problem, schedule, block, index);
+            apply(schedule, move);
+            auto neighbor_eval = evaluator.evaluate(schedule, move.l1, move.from1, move.l2, move.from2);
+
+            // Return the first improving neighbor
+            if (orcs::common::less(neighbor_eval, start_eval)) {
+                return {schedule, neighbor_eval};
+            }
+
+            undo(schedule, move);
+        }
+    }
+
+    // No improving neighbor
+    return entry;
+}
+
+std::tuple< orcs::Schedule, std::tuple<double, double> > orcs::Neighborhood::sampled(const Problem& problem,
+        const std::tuple< Schedule, std::tuple<double, double> >& entry) {
+
+    // Get the start solution
+    const auto& [start_schedule, start_eval] = entry;
+    std::mt19937& generator = (generator_ != nullptr ? *generator_ : own_generator_);
+
+    // Number of moves before each block
+    std::vector<long> offset(blocks(problem) + 1, 0);
+    for (int block = 0; block < blocks(problem); ++block) {
+        offset[block + 1] = offset[block] + count(problem, start_schedule, block);
+    }
+
+    // Evaluate all moves if the sample would not be smaller
+    if (offset.back() <= sample_size_) {
+        return exhaustive(problem, entry);
+    }
+
+    // Keep the best neighbor
+    auto [best_schedule, best_eval] = entry;
+    Move best_move;
+    bool improved = false;
+
+    // Evaluate the neighbors incrementally from the start solution
+    IncrementalEvaluator evaluator(problem, cache_);
+    evaluator.reset(start_schedule);
+
+    // Working schedule, modified in place by each move
+    Schedule schedule = start_schedule;
+
+    // Evaluate a random sample of the moves
+    std::uniform_int_distribution<long> distribution(0, offset.back() - 1);
+    for (long k = 0; k < sample_size_; ++k) {
+        long index = distribution(generator);
+        int block = static_cast<int>(std::upper_bound(offset.begin(), offset.end(), index) - offset.begin()) - 1;
+
+        // Build and evaluate the neighbor
+        Move move = move_at(problem, schedule, block, index - offset[block]);
+        apply(schedule, move);
+        auto neighbor_eval = evaluator.evaluate(schedule, move.l1, move.from1, move.l2, move.from2);
+        undo(schedule, move);
+
+        // Update the best neighbor
+        if (orcs::common::less(neighbor_eval, best_eval)) {
+            best_move = move;
+            best_eval = neighbor_eval;
+            improved = true;
+        }
+    }
+
+    // Materialize the best neighbor
+    if (improved) {
+        apply(best_schedule, best_move);
+    }
+
+    // Return the best neighbor
+    return {best_schedule, best_eval};
+}
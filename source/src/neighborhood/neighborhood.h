@@ -3,16 +3,51 @@
 
 #include <algorithm>
 #include <cmath>
+#include <functional>
 #include <limits>
 #include <random>
 #include <vector>
 
 #include "../problem/problem.h"
 #include "../util/common.h"
+#include "../util/evaluation_cache.h"
+#include "../util/incremental_evaluator.h"
+#include "../util/thread_pool.h"
 
 
 namespace orcs {
 
+    /**
+     * Lightweight description of a move. The switch at position idx1 of team
+     * l1 is moved to position target1 of team l2 (or of team l1, if the move
+     * changes a single team). For moves involving two switches, the switch at
+     * position idx2 of team l2 is moved to position target2 of team l1. Each
+     * neighborhood defines which of these fields are used by its moves.
+     */
+    struct Move {
+        int l1 = -1;
+        int idx1 = -1;
+        int target1 = -1;
+        int l2 = -1;
+        int idx2 = -1;
+        int target2 = -1;
+
+        // First index of the sequences of teams l1 and l2 changed by the move
+        int from1 = -1;
+        int from2 = -1;
+    };
+
+    /**
+     * Approaches to explore a neighborhood: the best neighbor (exhaustive
+     * scan), the first improving neighbor (in a random order of the moves)
+     * or the best neighbor of a random sample of the moves.
+     */
+    enum class Approach {
+        BEST,
+        FIRST,
+        SAMPLED
+    };
+
     /**
      * Interface implemented by all classes that defines a neighborhood.
      */
@@ -21,7 +56,20 @@ namespace orcs {
     public:
 
         /**
-         * Return the best neighbor of the given entry.
+         * Return the best neighbor of the given entry. The default
+         * implementation enumerates the moves of the neighborhood, applying
+         * and undoing each of them in place on a single working schedule.
+         * Only the best move is materialized in the returned schedule. If a
+         * thread pool is set, the blocks of moves are scanned in parallel and
+         * the best neighbor of each block is reduced in the order of the
+         * blocks, so ties are broken by the order of the moves.
+         *
+         * With the first-improvement approach, the blocks are visited in a
+         * random order and the moves of each block in a random cyclic order,
+         * and the first improving neighbor is returned. With the sampled
+         * approach, only a random sample of the moves (drawn with
+         * replacement) is evaluated. Both approaches scan the neighborhood
+         * sequentially.
          *
          * @param   problem
          *          Instance of the problem being optimized.
@@ -33,7 +81,7 @@ namespace orcs {
          *          containing the makespan and the sum of the completion times).
          */
         virtual std::tuple< Schedule, std::tuple<double, double> >
-        best(const Problem& problem, const std::tuple< Schedule, std::tuple<double, double> >& entry) = 0;
+        best(const Problem& problem, const std::tuple< Schedule, std::tuple<double, double> >& entry);
 
         /**
          * Return a neighbor, randomly chosen, from the start entry.
@@ -56,6 +104,148 @@ namespace orcs {
         any(const Problem& problem, const std::tuple< Schedule, std::tuple<double, double> >& entry,
                 std::mt19937& generator, bool feasible_only = true) = 0;
 
+        /**
+         * Return the number of blocks in which the moves of the neighborhood
+         * are partitioned (e.g., one block per team or pair of teams).
+         * Enumerating the blocks in ascending order enumerates all moves of
+         * the neighborhood.
+         *
+         * @param   problem
+         *          Instance of the problem being optimized.
+         * @return  The number of blocks.
+         */
+        virtual int blocks(const Problem& problem) const = 0;
+
+        /**
+         * Enumerate the moves of a block of the neighborhood from the given
+         * schedule.
+         *
+         * @param   problem
+         *          Instance of the problem being optimized.
+         * @param   schedule
+         *          The schedule from which the moves are enumerated.
+         * @param   block
+         *          The block of moves to enumerate.
+         * @param   visit
+         *          Function called for each move. The enumeration stops if
+         *          it returns false.
+         */
+        virtual void moves(const Problem& problem, const Schedule& schedule, int block,
+                const std::function<bool(const Move&)>& visit) = 0;
+
+        /**
+         * Return the number of moves of a block of the neighborhood from the
+         * given schedule.
+         *
+         * @param   problem
+         *          Instance of the problem being optimized.
+         * @param   schedule
+         *          The schedule from which the moves are enumerated.
+         * @param   block
+         *          The block of moves.
+         * @return  The number of moves enumerated by moves() for the block.
+         */
+        virtual long count(const Problem& problem, const Schedule& schedule, int block) const = 0;
+
+        /**
+         * Return a move of a block of the neighborhood by its position in
+         * the enumeration of the block.
+         *
+         * @param   problem
+         *          Instance of the problem being optimized.
+         * @param   schedule
+         *          The schedule from which the moves are enumerated.
+         * @param   block
+         *          The block of moves.
+         * @param   index
+         *          Position of the move, from 0 (zero) to count() - 1.
+         * @return  The move visited in that position by moves().
+         */
+        virtual Move move_at(const Problem& problem, const Schedule& schedule, int block, long index) const = 0;
+
+        /**
+         * Apply a move in place.
+         *
+         * @param   schedule
+         *          The schedule to modify.
+         * @param   move
+         *          The move to apply.
+         */
+        virtual void apply(Schedule& schedule, const Move& move) const = 0;
+
+        /**
+         * Undo a move previously applied in place, restoring the schedule
+         * to its state before the move.
+         *
+         * @param   schedule
+         *          The schedule to restore.
+         * @param   move
+         *          The move to undo.
+         */
+        virtual void undo(Schedule& schedule, const Move& move) const = 0;
+
+        /**
+         * Set the thread pool used to scan the neighborhood in parallel.
+         *
+         * @param   pool
+         *          The thread pool, or nullptr to scan the neighborhood
+         *          sequentially.
+         */
+        void set_thread_pool(ThreadPool* pool);
+
+        /**
+         * Set the cache used to look up (and store) the evaluations of the
+         * neighbors.
+         *
+         * @param   cache
+         *          The evaluation cache, or nullptr to disable caching.
+         */
+        void set_evaluation_cache(EvaluationCache* cache);
+
+        /**
+         * Set the approach used to explore the neighborhood.
+         *
+         * @param   approach
+         *          The approach (best, first or sampled).
+         * @param   generator
+         *          The random number generator used by the first-improvement
+         *          and sampled approaches. If set to nullptr, a generator
+         *          owned by the neighborhood is used.
+         * @param   sample_size
+         *          Number of moves evaluated by the sampled approach.
+         */
+        void set_approach(Approach approach, std::mt19937* generator = nullptr, long sample_size = 1000);
+
+        /**
+         * Destructor.
+         */
+        virtual ~Neighborhood() = default;
+
+    protected:
+
+        // Thread pool used to scan the neighborhood (nullptr if sequential)
+        ThreadPool* pool_ = nullptr;
+
+        // Cache of evaluations (nullptr if disabled)
+        EvaluationCache* cache_ = nullptr;
+
+        // Approach used to explore the neighborhood
+        Approach approach_ = Approach::BEST;
+        std::mt19937* generator_ = nullptr;
+        std::mt19937 own_generator_;
+        long sample_size_ = 1000;
+
+    private:
+
+        std::tuple< Schedule, std::tuple<double, double> >
+        exhaustive(const Problem& problem, const std::tuple< Schedule, std::tuple<double, double> >& entry);
+
+        std::tuple< Schedule, std::tuple<double, double> >
+        first(const Problem& problem, const std::tuple< Schedule, std::tuple<double, double> >& entry);
+
+        std::tuple< Schedule, std::tuple<double, double> >
+        sampled(const Problem& problem, const std::tuple< Schedule, std::tuple<double, double> >& entry);
+
     };
 
 }
@@ -1,44 +1,89 @@
 #include "reassignment.h"
 
 
-std::tuple< orcs::Schedule, std::tuple<double, double> > orcs::Reassignment::best(const Problem& problem,
-        const std::tuple< Schedule, std::tuple<double, double> >& entry) {
-
-    // Get the start solution
-    const auto& [start_schedule, start_eval] = entry;
+int orcs::Reassignment::blocks(const Problem& problem) const {
+    return problem.m;
+}
 
-    // Keep the best neighbor
-    auto [best_schedule, best_eval] = entry;
-
-    // Evaluate all neighbors
-    for (int l_origin = 1; l_origin <= problem.m; ++l_origin) {
-        for (int idx_origin = 0; idx_origin < start_schedule[l_origin].size(); ++idx_origin) {
-            for (int l_target = 1; l_target <= problem.m; ++l_target) {
-                if (l_target != l_origin) {
-                    for (int idx_target = 0; idx_target <= start_schedule[l_target].size(); ++idx_target) {
-
-                        // Build a neighbor
-                        Schedule neighbor_schedule = start_schedule;
-                        int i = neighbor_schedule[l_origin][idx_origin];
-                        neighbor_schedule[l_origin].erase(neighbor_schedule[l_origin].begin() + idx_origin);
-                        neighbor_schedule[l_target].insert(neighbor_schedule[l_target].begin() + idx_target, i);
-
-                        // Evaluate the neighbor
-                        auto neighbor_eval = orcs::common::evaluate(problem, neighbor_schedule);
-
-                        // Update the best neighbor
-                        if (orcs::common::less(neighbor_eval, best_eval)) {
-                            best_schedule = std::move(neighbor_schedule);
-                            best_eval = std::move(neighbor_eval);
-                        }
+void orcs::Reassignment::moves(const Problem& problem, const Schedule& schedule, int block,
+        const std::function<bool(const Move&)>& visit) {
+
+    // Enumerate the moves from team l_origin
+    int l_origin = block + 1;
+    for (int idx_origin = 0; idx_origin < schedule[l_origin].size(); ++idx_origin) {
+        for (int l_target = 1; l_target <= problem.m; ++l_target) {
+            if (l_target != l_origin) {
+                for (int idx_target = 0; idx_target <= schedule[l_target].size(); ++idx_target) {
+
+                    // Describe the move
+                    Move move;
+                    move.l1 = l_origin;
+                    move.idx1 = idx_origin;
+                    move.l2 = l_target;
+                    move.target1 = idx_target;
+                    move.from1 = idx_origin;
+                    move.from2 = idx_target;
+
+                    if (!visit(move)) {
+                        return;
                     }
                 }
             }
         }
     }
+}
+
+long orcs::Reassignment::count(const Problem& problem, const Schedule& schedule, int block) const {
+    int l_origin = block + 1;
+    long targets = 0;
+    for (int l_target = 1; l_target <= problem.m; ++l_target) {
+        if (l_target != l_origin) {
+            targets += schedule[l_target].size() + 1;
+        }
+    }
+
+    return static_cast<long>(schedule[l_origin].size()) * targets;
+}
+
+orcs::Move orcs::Reassignment::move_at(const Problem& problem, const Schedule& schedule, int block, long index) const {
+
+    // Number of targets of each switch of team l_origin
+    int l_origin = block + 1;
+    long targets = count(problem, schedule, block) / schedule[l_origin].size();
+
+    // Decode the positions of the move
+    int idx_origin = index / targets;
+    index %= targets;
+
+    int l_target = (l_origin == 1 ? 2 : 1);
+    while (index > schedule[l_target].size()) {
+        index -= schedule[l_target].size() + 1;
+        l_target = (l_target + 1 == l_origin ? l_target + 2 : l_target + 1);
+    }
+
+    int idx_target = index;
+
+    // Describe the move
+    Move move;
+    move.l1 = l_origin;
+    move.idx1 = idx_origin;
+    move.l2 = l_target;
+    move.target1 = idx_target;
+    move.from1 = idx_origin;
+    move.from2 = idx_target;
+    return move;
+}
+
+void orcs::Reassignment::apply(Schedule& schedule, const Move& move) const {
+    int i = schedule[move.l1][move.idx1];
+    schedule[move.l1].erase(schedule[move.l1].begin() + move.idx1);
+    schedule[move.l2].insert(schedule[move.l2].begin() + move.target1, i);
+}
 
-    // Return the best neighbor
-    return {best_schedule, best_eval};
+void orcs::Reassignment::undo(Schedule& schedule, const Move& move) const {
+    int i = schedule[move.l2][move.target1];
+    schedule[move.l2].erase(schedule[move.l2].begin() + move.target1);
+    schedule[move.l1].insert(schedule[move.l1].begin() + move.idx1, i);
 }
 
 std::tuple< orcs::Schedule, std::tuple<double, double> > orcs::Reassignment::any(const Problem& problem,
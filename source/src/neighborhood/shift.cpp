@@ -1,42 +1,68 @@
 #include "shift.h"
 
 
-std::tuple< orcs::Schedule, std::tuple<double, double> > orcs::Shift::best(const Problem& problem,
-        const std::tuple< Schedule, std::tuple<double, double> >& entry) {
+int orcs::Shift::blocks(const Problem& problem) const {
+    return problem.m + 1;
+}
 
-    // Get the start solution
-    const auto& [start_schedule, start_eval] = entry;
+void orcs::Shift::moves(const Problem& problem, const Schedule& schedule, int block,
+        const std::function<bool(const Move&)>& visit) {
+
+    // Enumerate the moves of team l
+    int l = block;
+    for (int idx_origin = 0; idx_origin < schedule[l].size(); ++idx_origin) {
+        for (int idx_target = 0; idx_target <= schedule[l].size() - 1; ++idx_target) {
+            if (idx_target != idx_origin) {
 
-    // Keep the best neighbor
-    auto [best_schedule, best_eval] = entry;
-
-    // Evaluate all neighbors
-    for (int l = 0; l <= problem.m; ++l) {
-        for (int idx_origin = 0; idx_origin < start_schedule[l].size(); ++idx_origin) {
-            for (int idx_target = 0; idx_target <= start_schedule[l].size() - 1; ++idx_target) {
-                if (idx_target != idx_origin) {
-
-                    // Build a neighbor
-                    Schedule neighbor_schedule = start_schedule;
-                    int i = neighbor_schedule[l][idx_origin];
-                    neighbor_schedule[l].erase(neighbor_schedule[l].begin() + idx_origin);
-                    neighbor_schedule[l].insert(neighbor_schedule[l].begin() + idx_target, i);
-
-                    // Evaluate the neighbor
-                    auto neighbor_eval = orcs::common::evaluate(problem, neighbor_schedule);
-
-                    // Update the best neighbor
-                    if (orcs::common::less(neighbor_eval, best_eval)) {
-                        best_schedule = std::move(neighbor_schedule);
-                        best_eval = std::move(neighbor_eval);
-                    }
+                // Describe the move
+                Move move;
+                move.l1 = l;
+                move.idx1 = idx_origin;
+                move.target1 = idx_target;
+                move.from1 = std::min(idx_origin, idx_target);
+
+                if (!visit(move)) {
+                    return;
                 }
             }
         }
     }
+}
+
+long orcs::Shift::count(const Problem& problem, const Schedule& schedule, int block) const {
+    long size = schedule[block].size();
+    return size * std::max(0L, size - 1);
+}
+
+orcs::Move orcs::Shift::move_at(const Problem& problem, const Schedule& schedule, int block, long index) const {
+
+    // Decode the positions of the move (the origin is skipped as target)
+    long size = schedule[block].size();
+    int idx_origin = index / (size - 1);
+    int idx_target = index % (size - 1);
+    if (idx_target >= idx_origin) {
+        ++idx_target;
+    }
+
+    // Describe the move
+    Move move;
+    move.l1 = block;
+    move.idx1 = idx_origin;
+    move.target1 = idx_target;
+    move.from1 = std::min(idx_origin, idx_target);
+    return move;
+}
+
+void orcs::Shift::apply(Schedule& schedule, const Move& move) const {
+    int i = schedule[move.l1][move.idx1];
+    schedule[move.l1].erase(schedule[move.l1].begin() + move.idx1);
+    schedule[move.l1].insert(schedule[move.l1].begin() + move.target1, i);
+}
 
-    // Return the best neighbor
-    return {best_schedule, best_eval};
+void orcs::Shift::undo(Schedule& schedule, const Move& move) const {
+    int i = schedule[move.l1][move.target1];
+    schedule[move.l1].erase(schedule[move.l1].begin() + move.target1);
+    schedule[move.l1].insert(schedule[move.l1].begin() + move.idx1, i);
 }
 
 std::tuple< orcs::Schedule, std::tuple<double, double> > orcs::Shift::any(const Problem& problem,
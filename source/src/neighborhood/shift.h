@@ -16,13 +16,23 @@ namespace orcs {
 
     public:
 
-        std::tuple< Schedule, std::tuple<double, double> > best(const Problem&
-                problem, const std::tuple< Schedule, std::tuple<double, double> >& entry) override;
-
         std::tuple< Schedule, std::tuple<double, double> > any(const Problem& problem,
                 const std::tuple< Schedule, std::tuple<double, double> >& entry, std::mt19937& generator,
                 bool feasible_only = true) override;
 
+        int blocks(const Problem& problem) const override;
+
+        void moves(const Problem& problem, const Schedule& schedule, int block,
+                const std::function<bool(const Move&)>& visit) override;
+
+        long count(const Problem& problem, const Schedule& schedule, int block) const override;
+
+        Move move_at(const Problem& problem, const Schedule& schedule, int block, long index) const override;
+
+        void apply(Schedule& schedule, const Move& move) const override;
+
+        void undo(Schedule& schedule, const Move& move) const override;
+
     };
 
 }
@@ -1,53 +1,95 @@
 #include "swap.h"
 
 
-std::tuple< orcs::Schedule, std::tuple<double, double> > orcs::Swap::best(const Problem& problem,
-        const std::tuple< Schedule, std::tuple<double, double> >& entry) {
-
-    // Get the start solution
-    const auto& [start_schedule, start_eval] = entry;
+int orcs::Swap::blocks(const Problem& problem) const {
+    return problem.m * problem.m;
+}
 
-    // Keep the best neighbor
-    auto [best_schedule, best_eval] = entry;
-
-    // Evaluate all neighbors
-    for (int l1 = 1; l1 <= problem.m; ++l1) {
-        if (start_schedule[l1].size() > 0) {
-            for (int l2 = l1 + 1; l2 <= problem.m; ++l2) {
-                if (start_schedule[l2].size() > 0) {
-                    for (int idx1 = 0; idx1 < start_schedule[l1].size(); ++idx1) {
-                        for (int idx2 = 0; idx2 < start_schedule[l2].size(); ++idx2) {
-                            for (int target1 = 0; target1 <= start_schedule[l2].size() - 1; ++target1) {
-                                for (int target2 = 0; target2 <= start_schedule[l1].size() - 1; ++target2) {
-
-                                    // Build a neighbor
-                                    Schedule neighbor_schedule = start_schedule;
-                                    int i_1 = neighbor_schedule[l1][idx1];
-                                    int i_2 = neighbor_schedule[l2][idx2];
-                                    neighbor_schedule[l1].erase(neighbor_schedule[l1].begin() + idx1);
-                                    neighbor_schedule[l2].erase(neighbor_schedule[l2].begin() + idx2);
-                                    neighbor_schedule[l2].insert(neighbor_schedule[l2].begin() + target1, i_1);
-                                    neighbor_schedule[l1].insert(neighbor_schedule[l1].begin() + target2, i_2);
-
-                                    // Evaluate the neighbor
-                                    auto neighbor_eval = orcs::common::evaluate(problem, neighbor_schedule);
-
-                                    // Update the best neighbor
-                                    if (orcs::common::less(neighbor_eval, best_eval)) {
-                                        best_schedule = std::move(neighbor_schedule);
-                                        best_eval = std::move(neighbor_eval);
-                                    }
-                                }
-                            }
+void orcs::Swap::moves(const Problem& problem, const Schedule& schedule, int block,
+        const std::function<bool(const Move&)>& visit) {
+
+    // Enumerate the moves between teams l1 and l2 (with l1 < l2)
+    int l1 = 1 + block / problem.m;
+    int l2 = 1 + block % problem.m;
+    if (l1 < l2 && schedule[l1].size() > 0 && schedule[l2].size() > 0) {
+        for (int idx1 = 0; idx1 < schedule[l1].size(); ++idx1) {
+            for (int idx2 = 0; idx2 < schedule[l2].size(); ++idx2) {
+                for (int target1 = 0; target1 <= schedule[l2].size() - 1; ++target1) {
+                    for (int target2 = 0; target2 <= schedule[l1].size() - 1; ++target2) {
+
+                        // Describe the move
+                        Move move;
+                        move.l1 = l1;
+                        move.idx1 = idx1;
+                        move.target1 = target1;
+                        move.l2 = l2;
+                        move.idx2 = idx2;
+                        move.target2 = target2;
+                        move.from1 = std::min(idx1, target2);
+                        move.from2 = std::min(idx2, target1);
+
+                        if (!visit(move)) {
+                            return;
                         }
                     }
                 }
             }
         }
     }
+}
+
+long orcs::Swap::count(const Problem& problem, const Schedule& schedule, int block) const {
+    int l1 = 1 + block / problem.m;
+    int l2 = 1 + block % problem.m;
+    long size1 = schedule[l1].size();
+    long size2 = schedule[l2].size();
+    return l1 < l2 ? size1 * size1 * size2 * size2 : 0L;
+}
+
+orcs::Move orcs::Swap::move_at(const Problem& problem, const Schedule& schedule, int block, long index) const {
+
+    // Decode the positions of the move (in the order of the loops of moves())
+    int l1 = 1 + block / problem.m;
+    int l2 = 1 + block % problem.m;
+    long size1 = schedule[l1].size();
+    long size2 = schedule[l2].size();
+
+    int target2 = index % size1;
+    index /= size1;
+    int target1 = index % size2;
+    index /= size2;
+    int idx2 = index % size2;
+    int idx1 = index / size2;
+
+    // Describe the move
+    Move move;
+    move.l1 = l1;
+    move.idx1 = idx1;
+    move.target1 = target1;
+    move.l2 = l2;
+    move.idx2 = idx2;
+    move.target2 = target2;
+    move.from1 = std::min(idx1, target2);
+    move.from2 = std::min(idx2, target1);
+    return move;
+}
+
+void orcs::Swap::apply(Schedule& schedule, const Move& move) const {
+    int i_1 = schedule[move.l1][move.idx1];
+    int i_2 = schedule[move.l2][move.idx2];
+    schedule[move.l1].erase(schedule[move.l1].begin() + move.idx1);
+    schedule[move.l2].erase(schedule[move.l2].begin() + move.idx2);
+    schedule[move.l2].insert(schedule[move.l2].begin() + move.target1, i_1);
+    schedule[move.l1].insert(schedule[move.l1].begin() + move.target2, i_2);
+}
 
-    // Return the best neighbor
-    return {best_schedule, best_eval};
+void orcs::Swap::undo(Schedule& schedule, const Move& move) const {
+    int i_1 = schedule[move.l2][move.target1];
+    int i_2 = schedule[move.l1][move.target2];
+    schedule[move.l1].erase(schedule[move.l1].begin() + move.target2);
+    schedule[move.l2].erase(schedule[move.l2].begin() + move.target1);
+    schedule[move.l2].insert(schedule[move.l2].begin() + move.idx2, i_2);
+    schedule[move.l1].insert(schedule[move.l1].begin() + move.idx1, i_1);
 }
 
 std::tuple< orcs::Schedule, std::tuple<double, double> > orcs::Swap::any(const Problem& problem,
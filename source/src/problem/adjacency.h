@@ -0,0 +1,158 @@
+#ifndef MANEUVER_SCHEDULING_ADJACENCY_H
+#define MANEUVER_SCHEDULING_ADJACENCY_H
+
+#include <cstddef>
+#include <set>
+#include <utility>
+#include <vector>
+
+
+namespace orcs {
+
+    /**
+     * Adjacency lists of a directed graph stored in compressed sparse row
+     * (CSR) format. The neighbors of all vertices are kept in a single
+     * contiguous array, in which the neighbors of vertex i are found between
+     * offset[i] and offset[i+1]. The neighbors of each vertex are sorted in
+     * ascending order.
+     */
+    class Adjacency {
+
+    public:
+
+        /**
+         * Read-only view over the neighbors of a vertex.
+         */
+        class Range {
+
+        public:
+
+            Range(const int* first, const int* last) : first_(first), last_(last) { }
+
+            const int* begin() const { return first_; }
+            const int* end() const { return last_; }
+            std::size_t size() const { return last_ - first_; }
+            bool empty() const { return first_ == last_; }
+            int operator[](std::size_t k) const { return first_[k]; }
+
+        private:
+
+            const int* first_;
+            const int* last_;
+
+        };
+
+        /**
+         * Default constructor. Create a graph without vertices.
+         */
+        Adjacency() = default;
+
+        /**
+         * Constructor. Build the CSR representation from adjacency sets.
+         *
+         * @param   sets
+         *          The adjacency sets, in which sets[i] contains the
+         *          neighbors of vertex i.
+         */
+        explicit Adjacency(const std::vector< std::set<int> >& sets) {
+            offset_.reserve(sets.size() + 1);
+            offset_.push_back(0);
+            for (const auto& neighbors : sets) {
+                index_.insert(index_.end(), neighbors.begin(), neighbors.end());
+                offset_.push_back(static_cast<int>(index_.size()));
+            }
+        }
+
+        /**
+         * Constructor. Build the graph from its CSR arrays.
+         *
+         * @param   offset
+         *          Offsets of the adjacency lists (one entry per vertex, plus
+         *          a last entry with the number of arcs).
+         * @param   index
+         *          Neighbors of all vertices, concatenated.
+         */
+        Adjacency(std::vector<int> offset, std::vector<int> index)
+                : offset_(std::move(offset)), index_(std::move(index)) { }
+
+        /**
+         * Build the graph with all arcs reversed (e.g., the successors from
+         * the predecessors).
+         *
+         * @return  The transposed graph.
+         */
+        Adjacency transpose() const {
+            std::size_t vertices = size();
+            std::vector<int> offset(vertices + 1, 0);
+            std::vector<int> index(index_.size());
+
+            // Count the arcs entering each vertex
+            for (auto j : index_) {
+                ++offset[j + 1];
+            }
+
+            for (std::size_t i = 0; i < vertices; ++i) {
+                offset[i + 1] += offset[i];
+            }
+
+            // Fill the adjacency lists (visiting sources in ascending order
+            // keeps each list sorted)
+            std::vector<int> next(offset.begin(), offset.end() - 1);
+            for (std::size_t i = 0; i < vertices; ++i) {
+                for (auto j : (*this)[i]) {
+                    index[next[j]++] = static_cast<int>(i);
+                }
+            }
+
+            return Adjacency(std::move(offset), std::move(index));
+        }
+
+        /**
+         * Return the neighbors of a vertex.
+         *
+         * @param   i
+         *          The vertex.
+         * @return  A view over the neighbors of vertex i.
+         */
+        inline Range operator[](int i) const {
+            return Range(index_.data() + offset_[i], index_.data() + offset_[i + 1]);
+        }
+
+        /**
+         * Return the number of vertices of the graph.
+         *
+         * @return  The number of vertices.
+         */
+        inline std::size_t size() const {
+            return offset_.empty() ? 0 : offset_.size() - 1;
+        }
+
+        /**
+         * Return the offsets of the adjacency lists.
+         *
+         * @return  The offset array of the CSR representation.
+         */
+        inline const std::vector<int>& offsets() const {
+            return offset_;
+        }
+
+        /**
+         * Return the neighbors of all vertices, concatenated.
+         *
+         * @return  The index array of the CSR representation.
+         */
+        inline const std::vector<int>& indices() const {
+            return index_;
+        }
+
+    private:
+
+        std::vector<int> offset_;
+        std::vector<int> index_;
+
+    };
+
+}
+
+
+#endif
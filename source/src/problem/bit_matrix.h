@@ -0,0 +1,100 @@
+#ifndef MANEUVER_SCHEDULING_BIT_MATRIX_H
+#define MANEUVER_SCHEDULING_BIT_MATRIX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace orcs {
+
+    /**
+     * Square matrix of bits packed in 64-bit words. Each row is stored in a
+     * contiguous block of words, so rows can be combined with bit-parallel
+     * operations.
+     */
+    class BitMatrix {
+
+    public:
+
+        /**
+         * Default constructor. Create an empty matrix.
+         */
+        BitMatrix() = default;
+
+        /**
+         * Constructor. Create a matrix with all bits cleared.
+         *
+         * @param   size
+         *          Number of rows (and columns) of the matrix.
+         */
+        explicit BitMatrix(std::size_t size)
+                : size_(size), words_((size + 63) / 64), bits_(size * ((size + 63) / 64), 0) { }
+
+        /**
+         * Return the value of a bit.
+         *
+         * @param   row
+         *          The row of the bit.
+         * @param   col
+         *          The column of the bit.
+         * @return  True if the bit is set, false otherwise.
+         */
+        inline bool operator()(std::size_t row, std::size_t col) const {
+            return (bits_[row * words_ + col / 64] >> (col % 64)) & 1u;
+        }
+
+        /**
+         * Set a bit.
+         *
+         * @param   row
+         *          The row of the bit.
+         * @param   col
+         *          The column of the bit.
+         */
+        inline void set(std::size_t row, std::size_t col) {
+            bits_[row * words_ + col / 64] |= std::uint64_t(1) << (col % 64);
+        }
+
+        /**
+         * Combine a row into another one with a bitwise OR.
+         *
+         * @param   target
+         *          The row updated.
+         * @param   source
+         *          The row combined into the target row.
+         * @return  True if the target row has changed, false otherwise.
+         */
+        inline bool merge(std::size_t target, std::size_t source) {
+            std::uint64_t* dst = bits_.data() + target * words_;
+            const std::uint64_t* src = bits_.data() + source * words_;
+            std::uint64_t changed = 0;
+            for (std::size_t w = 0; w < words_; ++w) {
+                changed |= src[w] & ~dst[w];
+                dst[w] |= src[w];
+            }
+
+            return changed != 0;
+        }
+
+        /**
+         * Return the number of rows (and columns) of the matrix.
+         *
+         * @return  The size of the matrix.
+         */
+        inline std::size_t size() const {
+            return size_;
+        }
+
+    private:
+
+        std::size_t size_ = 0;
+        std::size_t words_ = 0;
+        std::vector<std::uint64_t> bits_;
+
+    };
+
+}
+
+
+#endif
@@ -1,14 +1,74 @@
 #include "problem.h"
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <iostream>
+#include <limits>
+
+#include <cstdint>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "../util/common.h"
 
 
+namespace {
+
+    // Identification of binary instance files
+    constexpr char BINARY_MAGIC[8] = {'O', 'R', 'C', 'S', 'S', 'C', 'H', 'D'};
+
+    // Version of the binary format
+    constexpr std::uint32_t BINARY_VERSION = 1;
+
+    // Value used to check that a file was written with the same byte order
+    constexpr std::uint32_t BINARY_BYTE_ORDER = 0x01020304;
+
+    // Header of binary instance files. Offsets are in bytes, from the
+    // beginning of the file.
+    struct BinaryHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byte_order;
+        std::int32_t n;
+        std::int32_t m;
+        std::uint64_t arcs;
+        std::uint64_t technology_offset;
+        std::uint64_t p_offset;
+        std::uint64_t predecessors_offset;
+        std::uint64_t setup_offset;
+        std::uint64_t size;
+    };
+
+}
+
+
 orcs::Problem::Problem(const std::string& filename) {
 
+    // Check the format of the file
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    char magic[sizeof(BINARY_MAGIC)] = {0};
+    file.read(magic, sizeof(magic));
+    bool binary = file.gcount() == sizeof(magic) && std::equal(magic, magic + sizeof(magic), BINARY_MAGIC);
+    file.close();
+
+    // Read the data
+    if (binary) {
+        load_binary(filename);
+    } else {
+        load_text(filename);
+    }
+
+    // Compute the successors and the full precedence matrix
+    build_precedence();
+}
+
+void orcs::Problem::load_text(const std::string& filename) {
+
     // Open file
     std::ifstream file(filename.c_str());
     std::string token;
@@ -20,11 +80,16 @@ orcs::Problem::Problem(const std::string& filename) {
 
     // Initialize the data structures
     technology = std::vector<Technology>(n + 1, Technology::UNKNOWN);
-    predecessors = std::vector< std::set<int> >(n + 1, std::set<int>());
-    successors = std::vector< std::set<int> >(n + 1, std::set<int>());
-    precedence = std::vector< std::vector<bool> >(n + 1, std::vector<bool>(n + 1, false));
+    std::vector< std::set<int> > predecessors_set(n + 1, std::set<int>());
     p = std::vector<double>(n + 1, 0.0);
-    s = std::vector< std::vector< std::vector<double> > >(n + 1, std::vector< std::vector<double> >(n + 1, std::vector<double>(m + 1, 0.0)));
+
+    std::size_t setup_count = static_cast<std::size_t>(m + 1) * (n + 1) * (n + 1);
+    double* setup_times = AlignedAllocator<double>().allocate(setup_count);
+    std::fill(setup_times, setup_times + setup_count, 0.0);
+    s = setup_times;
+    s_storage_ = std::shared_ptr<const void>(setup_times, [setup_count](const void* ptr) {
+        AlignedAllocator<double>().deallocate(static_cast<double*>(const_cast<void*>(ptr)), setup_count);
+    });
 
     // Read switches data
     for (int i = 1; i <= n; ++i) {
@@ -64,59 +129,243 @@ orcs::Problem::Problem(const std::string& filename) {
             file >> token;
             int i = std::stoi(token);
 
-            predecessors[j].insert(i);
-            successors[i].insert(j);
+            predecessors_set[j].insert(i);
         }
     }
 
     // Read the travel time (setup time)
+    std::size_t pos = static_cast<std::size_t>(n + 1) * (n + 1);
     for (int l = 1; l <= m; ++l) {
         for (int i = 0; i <= n; ++i) {
             for (int j = 0; j <= n; ++j) {
                 file >> token;
-                s[i][j][l] = std::stod(token);
+                setup_times[pos++] = std::stod(token);
             }
         }
     }
 
-    // Compute the full precedence matrix
-    std::vector<bool> processed(n + 1, false);
-    std::set<int> pending;
-    for (std::size_t j = 1; j <= n; ++j) {
+    // Build the CSR representation of the precedence graph
+    predecessors = Adjacency(predecessors_set);
+
+    // Close the file
+    file.close();
+}
 
-        // Clear the data structures used
-        std::fill(processed.begin(), processed.end(), false);
-        pending.clear();
+void orcs::Problem::load_binary(const std::string& filename) {
 
-        // Initialize the data structures
-        for (auto i : predecessors[j]) {
-            pending.insert(i);
+    // Map the file into memory
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::string("File \"" + filename + "\" cannot be opened.");
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(BinaryHeader))) {
+        ::close(fd);
+        throw std::string("File \"" + filename + "\" is not a valid binary instance.");
+    }
+
+    std::size_t size = static_cast<std::size_t>(info.st_size);
+    void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+
+    if (data == MAP_FAILED) {
+        throw std::string("File \"" + filename + "\" cannot be mapped into memory.");
+    }
+
+    // The mapping is kept while the setup times are in use
+    s_storage_ = std::shared_ptr<const void>(data, [size](const void* ptr) {
+        ::munmap(const_cast<void*>(ptr), size);
+    });
+
+    const char* base = static_cast<const char*>(data);
+
+    // Check the header
+    BinaryHeader header;
+    std::memcpy(&header, base, sizeof(header));
+
+    if (header.version != BINARY_VERSION) {
+        throw std::string("Binary instance \"" + filename + "\" has an unsupported version.");
+    }
+
+    if (header.byte_order != BINARY_BYTE_ORDER) {
+        throw std::string("Binary instance \"" + filename + "\" was written with a different byte order.");
+    }
+
+    // Check the sizes before any arithmetic on them. All lengths are computed
+    // in 64 bits and each section is checked as an offset within the file and
+    // a length within the rest of it, so no sum can wrap around.
+    auto fits = [size](std::uint64_t offset, std::uint64_t length) -> bool {
+        return offset <= size && length <= size - offset;
+    };
+
+    bool valid = header.n >= 0 && header.m >= 0 && header.size == size && header.arcs <= size
+            && static_cast<std::uint64_t>(header.n) + 1 <= size;
+
+    std::uint64_t switches = static_cast<std::uint64_t>(header.n) + 1;
+    std::uint64_t teams = static_cast<std::uint64_t>(header.m) + 1;
+    valid = valid && switches * switches <= size / sizeof(double)
+            && teams <= size / sizeof(double) / (switches * switches);
+
+    valid = valid
+            && fits(header.technology_offset, switches * sizeof(std::uint8_t))
+            && header.p_offset % alignof(double) == 0
+            && fits(header.p_offset, switches * sizeof(double))
+            && header.predecessors_offset % alignof(std::int32_t) == 0
+            && fits(header.predecessors_offset, (switches + 1 + header.arcs) * sizeof(std::int32_t))
+            && header.setup_offset % CACHE_LINE_SIZE == 0
+            && fits(header.setup_offset, teams * switches * switches * sizeof(double));
+
+    if (!valid) {
+        throw std::string("File \"" + filename + "\" is not a valid binary instance.");
+    }
+
+    n = header.n;
+    m = header.m;
+
+    // Technologies and processing times
+    technology = std::vector<Technology>(n + 1, Technology::UNKNOWN);
+    for (int i = 0; i <= n; ++i) {
+        auto value = static_cast<std::uint8_t>(base[header.technology_offset + i]);
+        if (value > static_cast<std::uint8_t>(Technology::REMOTE)) {
+            throw std::string("File \"" + filename + "\" is not a valid binary instance.");
         }
 
-        // Compute the precedence graph of j
-        while (!pending.empty()) {
+        technology[i] = static_cast<Technology>(value);
+    }
+
+    p = std::vector<double>(n + 1, 0.0);
+    std::memcpy(p.data(), base + header.p_offset, (n + 1) * sizeof(double));
+
+    // Predecessors
+    std::vector<int> offset(n + 2, 0);
+    std::vector<int> index(header.arcs, 0);
+    std::memcpy(offset.data(), base + header.predecessors_offset, (n + 2) * sizeof(std::int32_t));
+    std::memcpy(index.data(), base + header.predecessors_offset + (n + 2) * sizeof(std::int32_t),
+            header.arcs * sizeof(std::int32_t));
+
+    // Check the CSR arrays: the offsets must be non-decreasing from 0 (zero)
+    // to the number of arcs, and the predecessors must be switches
+    valid = offset.front() == 0 && static_cast<std::uint64_t>(offset.back()) == header.arcs;
+    for (int i = 0; valid && i <= n; ++i) {
+        valid = offset[i] <= offset[i + 1];
+    }
+
+    for (std::size_t k = 0; valid && k < index.size(); ++k) {
+        valid = index[k] >= 1 && index[k] <= n;
+    }
+
+    if (!valid) {
+        throw std::string("File \"" + filename + "\" is not a valid binary instance.");
+    }
+
+    predecessors = Adjacency(std::move(offset), std::move(index));
+
+    // Setup times are used in place
+    s = reinterpret_cast<const double*>(base + header.setup_offset);
+}
+
+void orcs::Problem::build_precedence() {
+
+    // Successors in CSR format
+    successors = predecessors.transpose();
 
-            // Get an element from the pending set
-            auto iter = pending.begin();
-            int i = *iter;
-            pending.erase(iter);
+    // Compute the full precedence matrix. The switches are visited in reverse
+    // topological order, so the row of a switch is complete once the rows of
+    // all its successors have been merged into it.
+    precedence = BitMatrix(n + 1);
 
-            // Update the precedence matrix
-            precedence[i][j] = true;
+    std::vector<int> order;
+    std::vector<int> pendings(n + 1, 0);
+    order.reserve(n + 1);
+    for (int i = 0; i <= n; ++i) {
+        pendings[i] = successors[i].size();
+        if (pendings[i] == 0) {
+            order.push_back(i);
+        }
+    }
 
-            // Check i as processed
-            processed[i] = true;
+    for (std::size_t pos = 0; pos < order.size(); ++pos) {
+        int i = order[pos];
+        for (auto k : predecessors[i]) {
+            if (--pendings[k] == 0) {
+                order.push_back(k);
+            }
+        }
+    }
 
-            // Add the predecessors of i into the pending set
-            for (auto k : predecessors[i]) {
-                if (!processed[k]) {
-                    pending.insert(k);
+    for (auto i : order) {
+        for (auto k : successors[i]) {
+            precedence.set(i, k);
+            precedence.merge(i, k);
+        }
+    }
+
+    // If the precedence graph has cycles, the switches involved are not
+    // ordered. Their rows are computed by propagating until a fixed point.
+    if (order.size() < n + 1) {
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (int i = 0; i <= n; ++i) {
+                if (pendings[i] > 0) {
+                    for (auto k : successors[i]) {
+                        if (!precedence(i, k)) {
+                            precedence.set(i, k);
+                            changed = true;
+                        }
+                        changed = precedence.merge(i, k) || changed;
+                    }
                 }
             }
         }
     }
+}
 
-    // Close the file
+void orcs::Problem::save(const std::string& filename) const {
+
+    // Compute the layout of the file
+    BinaryHeader header;
+    std::memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    header.version = BINARY_VERSION;
+    header.byte_order = BINARY_BYTE_ORDER;
+    header.n = n;
+    header.m = m;
+    header.arcs = predecessors.indices().size();
+
+    std::size_t setup_count = static_cast<std::size_t>(m + 1) * (n + 1) * (n + 1);
+    auto align = [](std::uint64_t offset, std::uint64_t alignment) {
+        return (offset + alignment - 1) / alignment * alignment;
+    };
+
+    header.technology_offset = sizeof(BinaryHeader);
+    header.p_offset = align(header.technology_offset + (n + 1) * sizeof(std::uint8_t), sizeof(double));
+    header.predecessors_offset = header.p_offset + (n + 1) * sizeof(double);
+    header.setup_offset = align(header.predecessors_offset + (n + 2 + header.arcs) * sizeof(std::int32_t), CACHE_LINE_SIZE);
+    header.size = header.setup_offset + setup_count * sizeof(double);
+
+    // Fill the buffer
+    std::vector<char> buffer(header.size, 0);
+    std::memcpy(buffer.data(), &header, sizeof(header));
+
+    for (int i = 0; i <= n; ++i) {
+        buffer[header.technology_offset + i] = static_cast<char>(technology[i]);
+    }
+
+    std::memcpy(buffer.data() + header.p_offset, p.data(), (n + 1) * sizeof(double));
+    std::memcpy(buffer.data() + header.predecessors_offset, predecessors.offsets().data(),
+            (n + 2) * sizeof(std::int32_t));
+    std::memcpy(buffer.data() + header.predecessors_offset + (n + 2) * sizeof(std::int32_t),
+            predecessors.indices().data(), header.arcs * sizeof(std::int32_t));
+    std::memcpy(buffer.data() + header.setup_offset, s, setup_count * sizeof(double));
+
+    // Write the file
+    std::ofstream file(filename.c_str(), std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::string("File \"" + filename + "\" cannot be opened for writing.");
+    }
+
+    file.write(buffer.data(), buffer.size());
     file.close();
 }
 
@@ -137,60 +386,65 @@ std::vector<double> orcs::Problem::start_time(const Schedule &schedule) const {
     t[0] = 0; // teams/machines are available at moment 0
 
     // Auxiliary structures
-    std::vector<int> index(m + 1, 0);       // next index to analyse of each schedule
-    std::vector<int> location(m + 1, 0);    // current location of each team
+    std::vector<int> team(n + 1, -1);       // team of each switch (-1 if not scheduled)
+    std::vector<int> index(n + 1, -1);      // index of each switch in the sequence of its team
     std::vector<int> pendings(n + 1, 0);    // number of pending predecessors switch operations
+    std::vector<int> ready;                 // switches ready to be processed (FIFO)
+    ready.reserve(n);
 
+    // A switch waits for its predecessors and for the switch before it in the
+    // sequence of its team
     for (int l = 0; l <= m; ++l) {
         for (int idx = 0; idx < schedule[l].size(); ++idx) {
-            pendings[schedule[l][idx]] = predecessors[schedule[l][idx]].size();
+            int j = schedule[l][idx];
+            team[j] = l;
+            index[j] = idx;
+            pendings[j] = predecessors[j].size() + (idx > 0 ? 1 : 0);
         }
     }
 
-    // Compute start times
-    int count = 0;
-    bool feasibility = true;
-    while (count < n && feasibility) {
-
-        feasibility = false;
-        for (int l = 0; l <= m; ++l) {
-            if (index[l] < schedule[l].size()) {
-
-                // Get the switch/task
-                int j = schedule[l][index[l]];
-
-                if (pendings[j] == 0) {
-
-                    // Get the current location of the team/machine
-                    int i = location[l];
-
-                    // Compute the start time
-                    if (l != 0) {
-                        t[j] = t[i] + p[i] + s[i][j][l];
-                    } else {
-                        t[j] = 0.0;
-                    }
-
-                    // Wait predecessor maneuvers
-                    for (auto k : predecessors[j]) {
-                        t[j] = std::max(t[j], t[k] + p[k]);
-                    }
+    for (int l = 0; l <= m; ++l) {
+        for (auto j : schedule[l]) {
+            if (pendings[j] == 0) {
+                ready.push_back(j);
+            }
+        }
+    }
 
-                    // Update the pending counters
-                    for (auto k : successors[j]) {
-                        --pendings[k];
-                    }
+    // Compute start times in topological order. If the schedule contains a
+    // cycle (or a switch waits for a predecessor not scheduled), the switches
+    // involved are never ready and keep infinite start times.
+    for (std::size_t pos = 0; pos < ready.size(); ++pos) {
+
+        // Get the switch/task
+        int j = ready[pos];
+        int l = team[j];
+        int idx = index[j];
+
+        // Compute the start time
+        if (l != 0) {
+            int i = (idx > 0 ? schedule[l][idx - 1] : 0);
+            t[j] = t[i] + p[i] + setup(i, j, l);
+        } else {
+            t[j] = 0.0;
+        }
 
-                    // Update the index and team's location
-                    ++index[l];
-                    location[l] = j;
+        // Wait predecessor maneuvers
+        for (auto k : predecessors[j]) {
+            t[j] = std::max(t[j], t[k] + p[k]);
+        }
 
-                    // Increment the number of switch operations analysed
-                    ++count;
+        // Update the pending counters
+        for (auto k : successors[j]) {
+            if (team[k] >= 0 && --pendings[k] == 0) {
+                ready.push_back(k);
+            }
+        }
 
-                    // The solution is feasible so far
-                    feasibility = true;
-                }
+        if (idx + 1 < schedule[l].size()) {
+            int k = schedule[l][idx + 1];
+            if (--pendings[k] == 0) {
+                ready.push_back(k);
             }
         }
     }
@@ -2,12 +2,17 @@
 #define MANEUVER_SCHEDULING_PROBLEM_H
 
 #include <cstddef>
+#include <memory>
 #include <tuple>
 #include <vector>
 #include <set>
 #include <string>
 #include <ostream>
 
+#include "adjacency.h"
+#include "bit_matrix.h"
+#include "../util/aligned_allocator.h"
+
 
 namespace orcs {
 
@@ -77,39 +82,76 @@ namespace orcs {
         std::vector<double> p;
 
         /**
-         * Displacement time between locations, in which s[i][j] is the time
-         * taken to displace from i to j. In scheduling problems it is equivalent
-         * to the setup time (setup dependent on the sequence and machine).
+         * Displacement time between locations, in which setup(i, j, l) is the
+         * time taken by team l to displace from i to j. In scheduling problems
+         * it is equivalent to the setup time (setup dependent on the sequence
+         * and machine). The times are kept in a single buffer, aligned to
+         * cache lines, laid out team-major (i.e., indexed [l][i][j]), so the
+         * times of a team are contiguous. The layer of team 0 (remotely
+         * controlled switches) is filled with zeros. The buffer is either
+         * owned by the problem or mapped from a binary instance file.
          */
-        std::vector< std::vector< std::vector<double> > > s;
+        const double* s = nullptr;
 
         /**
-         * Set of predecessors of each switch maneuver, in which predecessors[j]
-         * is the set of switches that must be maneuvered before switch j.
+         * Predecessors of each switch maneuver (in CSR format), in which
+         * predecessors[j] lists the switches that must be maneuvered before
+         * switch j.
          */
-        std::vector< std::set<int> > predecessors;
+        Adjacency predecessors;
 
         /**
-         * Set of successors of each switch maneuver, in which successors[i] is
-         * the set of switches that cannot be maneuvered before switch i is
-         * maneuvered.
+         * Successors of each switch maneuver (in CSR format), in which
+         * successors[i] lists the switches that cannot be maneuvered before
+         * switch i is maneuvered.
          */
-        std::vector< std::set<int> > successors;
+        Adjacency successors;
 
         /**
-         * Precedence matrix, in which precedence[i][j] is true if i must
-         * precede j, false otherwise.
+         * Transitive closure of the precedence graph, packed as a bit matrix,
+         * in which precedence(i, j) is true if i must precede j (directly or
+         * not), false otherwise.
          */
-        std::vector< std::vector<bool> > precedence;
+        BitMatrix precedence;
 
         /**
-         * Constructor.
+         * Constructor. The file may be either in the text format or in the
+         * binary format (see save()), which is detected automatically. Binary
+         * files are memory-mapped and their setup times are used in place.
          *
          * @param   filename
          *          Path to the file containing the data.
          */
         Problem(const std::string& filename);
 
+        /**
+         * Write the problem to a file in the binary format. The file starts
+         * with a versioned header followed by the technologies, the
+         * processing times, the predecessors (in CSR format) and the setup
+         * times (in the same layout used in memory, aligned to 64 bytes).
+         * Numbers are written in the byte order of the host.
+         *
+         * @param   filename
+         *          Path to the file to write.
+         */
+        void save(const std::string& filename) const;
+
+        /**
+         * Return the setup time (displacement time) of team l from the
+         * location of switch i to the location of switch j.
+         *
+         * @param   i
+         *          The origin switch (0 is the team's base).
+         * @param   j
+         *          The destination switch.
+         * @param   l
+         *          The team.
+         * @return  The setup time.
+         */
+        inline double setup(int i, int j, int l) const {
+            return s[(static_cast<std::size_t>(l) * (n + 1) + i) * (n + 1) + j];
+        }
+
         /**
          * Computes the makespan of a schedule (i.e., the moment in which the
          * last task/maneuver is completed).
@@ -146,6 +188,20 @@ namespace orcs {
          */
         bool is_feasible(const Schedule& schedule, std::string *msg = nullptr) const;
 
+    private:
+
+        // Owner of the buffer of setup times (allocated or memory-mapped)
+        std::shared_ptr<const void> s_storage_;
+
+        // Read the problem from a file in the text format
+        void load_text(const std::string& filename);
+
+        // Read the problem from a file in the binary format
+        void load_binary(const std::string& filename);
+
+        // Compute the successors and the precedence matrix from predecessors
+        void build_precedence();
+
     };
 }
 
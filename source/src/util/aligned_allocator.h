@@ -0,0 +1,76 @@
+#ifndef MANEUVER_SCHEDULING_ALIGNED_ALLOCATOR_H
+#define MANEUVER_SCHEDULING_ALIGNED_ALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+
+
+namespace orcs {
+
+    /**
+     * Alignment (in bytes) of the buffers used by the hot data of the problem.
+     * It matches the size of a cache line.
+     */
+    constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+    /**
+     * Standard-compliant allocator that returns memory aligned to a given
+     * boundary. It is used to keep large buffers (e.g., the setup times)
+     * aligned to cache lines.
+     */
+    template <typename T, std::size_t Alignment = CACHE_LINE_SIZE>
+    class AlignedAllocator {
+
+    public:
+
+        using value_type = T;
+
+        template <typename U>
+        struct rebind {
+            using other = AlignedAllocator<U, Alignment>;
+        };
+
+        AlignedAllocator() noexcept = default;
+
+        template <typename U>
+        AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept { }
+
+        /**
+         * Allocate an aligned buffer.
+         *
+         * @param   count
+         *          Number of objects in the buffer.
+         * @return  A pointer to the buffer.
+         */
+        T* allocate(std::size_t count) {
+            return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+        }
+
+        /**
+         * Release a buffer previously allocated by this allocator.
+         *
+         * @param   ptr
+         *          Pointer to the buffer.
+         * @param   count
+         *          Number of objects in the buffer.
+         */
+        void deallocate(T* ptr, std::size_t count) noexcept {
+            ::operator delete(ptr, std::align_val_t(Alignment));
+        }
+
+        template <typename U>
+        bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept {
+            return true;
+        }
+
+        template <typename U>
+        bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept {
+            return false;
+        }
+
+    };
+
+}
+
+
+#endif
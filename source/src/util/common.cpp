@@ -1,7 +1,10 @@
 #include "common.h"
 
 #include <algorithm>
+#include <cctype>
 #include <cmath>
+#include <fstream>
+#include <sstream>
 #include <vector>
 
 
@@ -111,3 +114,78 @@ void orcs::common::print_solution(std::ostream& os, const Schedule& schedule, co
         os << "]" << std::endl;
     }
 }
+
+void orcs::common::write_solution(const std::string& filename, const Schedule& schedule) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        throw std::string("File \"" + filename + "\" cannot be opened.");
+    }
+
+    print_solution(file, schedule);
+}
+
+orcs::Schedule orcs::common::read_solution(const std::string& filename, const Problem& problem) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::string("File \"" + filename + "\" cannot be opened.");
+    }
+
+    Schedule schedule = create_empty_schedule(problem.m);
+    std::vector<bool> read(problem.m + 1, false);
+
+    std::string line;
+    while (std::getline(file, line)) {
+
+        // Skip empty lines
+        if (std::all_of(line.begin(), line.end(), [](unsigned char c) -> bool { return std::isspace(c); })) {
+            continue;
+        }
+
+        // Split the line into the label of the team and the list of switches
+        auto colon = line.find(':');
+        auto open = line.find('[', colon);
+        auto close = line.find(']', open);
+        if (colon == std::string::npos || open == std::string::npos || close == std::string::npos) {
+            throw std::string("Invalid line in solution file: \"" + line + "\".");
+        }
+
+        // Team
+        std::istringstream label(line.substr(0, colon));
+        std::string name;
+        int l = 0;
+        label >> name;
+        if (name == "TEAM") {
+            if (!(label >> l) || l < 1 || l > problem.m) {
+                throw std::string("Invalid team in solution file: \"" + line + "\".");
+            }
+        } else if (name != "REMOTE") {
+            throw std::string("Invalid line in solution file: \"" + line + "\".");
+        }
+
+        if (read[l]) {
+            throw std::string("Team listed more than once in solution file: \"" + line + "\".");
+        }
+        read[l] = true;
+
+        // Switches (the moments in parentheses are ignored)
+        std::istringstream list(line.substr(open + 1, close - open - 1));
+        std::string item;
+        while (std::getline(list, item, ',')) {
+            std::istringstream entry(item);
+            int i;
+            if (entry >> i) {
+                schedule[l].push_back(i);
+            } else if (item.find_first_not_of(" \t\r") != std::string::npos) {
+                throw std::string("Invalid switch in solution file: \"" + line + "\".");
+            }
+        }
+    }
+
+    // Check the solution
+    std::string msg;
+    if (!problem.is_feasible(schedule, &msg)) {
+        throw std::string("Infeasible solution in file \"" + filename + "\": " + msg);
+    }
+
+    return schedule;
+}
@@ -265,6 +265,25 @@ namespace orcs {
          */
         void print_solution(std::ostream& os, const Schedule& schedule, const Problem& problem);
 
+        /**
+         * Write a solution to a file, in the same format of print_solution().
+         * @param filename The name of the file.
+         * @param schedule The solution to write.
+         */
+        void write_solution(const std::string& filename, const Schedule& schedule);
+
+        /**
+         * Read a solution from a file in the format of print_solution() (with
+         * or without the moment in which each switch is maneuvered, which is
+         * ignored). Teams not listed in the file are left empty. An exception
+         * is thrown if the file cannot be read or if the solution is not
+         * feasible for the instance.
+         * @param filename The name of the file.
+         * @param problem The instance of the problem.
+         * @return The solution read.
+         */
+        Schedule read_solution(const std::string& filename, const Problem& problem);
+
         /**
          * Auxiliary structure used to compare tuples.
          */
@@ -0,0 +1,85 @@
+#include "evaluation_cache.h"
+
+
+orcs::EvaluationCache::EvaluationCache(const Problem& problem, std::size_t capacity)
+        : n_(problem.n), hits_(0), misses_(0) {
+
+    // The capacity is a power of two, so slots are found by masking the key
+    std::size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    mask_ = size - 1;
+    table_ = std::vector<Entry>(size);
+}
+
+std::uint64_t orcs::EvaluationCache::hash(const Schedule& schedule) const {
+    std::uint64_t key = 0;
+    for (int l = 0; l < schedule.size(); ++l) {
+        key ^= hash(schedule[l], l);
+    }
+
+    return key;
+}
+
+std::uint64_t orcs::EvaluationCache::hash(const std::vector<int>& sequence, int l, int from) const {
+    std::uint64_t key = 0;
+    int i = (from > 0 ? sequence[from - 1] : 0);
+    for (int idx = from; idx < sequence.size(); ++idx) {
+        key ^= arc(i, sequence[idx], l);
+        i = sequence[idx];
+    }
+
+    return key;
+}
+
+std::uint64_t orcs::EvaluationCache::insertion(const std::vector<int>& sequence, int l, int idx, int j) const {
+    int i = (idx > 0 ? sequence[idx - 1] : 0);
+    std::uint64_t key = arc(i, j, l);
+    if (idx < sequence.size()) {
+        key ^= arc(i, sequence[idx], l) ^ arc(j, sequence[idx], l);
+    }
+
+    return key;
+}
+
+bool orcs::EvaluationCache::find(std::uint64_t key, std::tuple<double, double>& evaluation) {
+    std::size_t slot = key & mask_;
+    bool found = false;
+    {
+        std::lock_guard<std::mutex> lock(locks_[slot % STRIPES]);
+        const Entry& entry = table_[slot];
+        if (key != 0 && entry.key == key) {
+            evaluation = {entry.makespan, entry.sum_completions};
+            found = true;
+        }
+    }
+
+    if (found) {
+        ++hits_;
+    } else {
+        ++misses_;
+    }
+
+    return found;
+}
+
+void orcs::EvaluationCache::insert(std::uint64_t key, const std::tuple<double, double>& evaluation) {
+    if (key != 0) {
+        std::size_t slot = key & mask_;
+        std::lock_guard<std::mutex> lock(locks_[slot % STRIPES]);
+        Entry& entry = table_[slot];
+        entry.key = key;
+        entry.makespan = std::get<0>(evaluation);
+        entry.sum_completions = std::get<1>(evaluation);
+    }
+}
+
+long orcs::EvaluationCache::hits() const {
+    return hits_.load();
+}
+
+long orcs::EvaluationCache::misses() const {
+    return misses_.load();
+}
@@ -0,0 +1,158 @@
+#ifndef MANEUVER_SCHEDULING_EVALUATION_CACHE_H
+#define MANEUVER_SCHEDULING_EVALUATION_CACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "../problem/problem.h"
+
+
+namespace orcs {
+
+    /**
+     * Bounded, thread-safe cache of schedule evaluations. Schedules are
+     * identified by a Zobrist-style hash: each arc (i, j, l), meaning that
+     * team l moves from switch i to switch j, has a pseudo-random key, and
+     * the hash of a schedule is the XOR of the keys of its arcs (the first
+     * arc of each team starts at 0). A move changes a few arcs, so the hash
+     * of a neighbor can be updated incrementally. The table is direct-mapped
+     * (a new entry replaces the old one in the same slot) and is guarded by
+     * striped locks.
+     */
+    class EvaluationCache {
+
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param   problem
+         *          Instance of the problem being optimized.
+         * @param   capacity
+         *          Maximum number of entries (rounded up to a power of two).
+         */
+        EvaluationCache(const Problem& problem, std::size_t capacity);
+
+        /**
+         * Return the key of an arc.
+         *
+         * @param   i
+         *          The switch the team leaves (0 is the team's base).
+         * @param   j
+         *          The switch the team arrives at.
+         * @param   l
+         *          The team.
+         * @return  The key of the arc.
+         */
+        inline std::uint64_t arc(int i, int j, int l) const {
+            std::uint64_t x = ((static_cast<std::uint64_t>(l) * (n_ + 1) + i) * (n_ + 1) + j)
+                    + 0x9E3779B97F4A7C15ULL;
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+            return x ^ (x >> 31);
+        }
+
+        /**
+         * Compute the hash of a schedule.
+         *
+         * @param   schedule
+         *          The schedule.
+         * @return  The hash of the schedule.
+         */
+        std::uint64_t hash(const Schedule& schedule) const;
+
+        /**
+         * Compute the hash of the arcs of a sequence from a given position
+         * onwards (including the arc that arrives at that position).
+         *
+         * @param   sequence
+         *          The sequence of switches of team l.
+         * @param   l
+         *          The team.
+         * @param   from
+         *          The first position considered.
+         * @return  The hash of the arcs.
+         */
+        std::uint64_t hash(const std::vector<int>& sequence, int l, int from = 0) const;
+
+        /**
+         * Compute the change in the hash of a sequence when a switch is
+         * inserted into it. Since the hash is a XOR, the same value is the
+         * change when the switch is removed from that position.
+         *
+         * @param   sequence
+         *          The sequence of switches of team l, without switch j.
+         * @param   l
+         *          The team.
+         * @param   idx
+         *          The position in which switch j is inserted.
+         * @param   j
+         *          The switch inserted.
+         * @return  The value to XOR into the hash of the schedule.
+         */
+        std::uint64_t insertion(const std::vector<int>& sequence, int l, int idx, int j) const;
+
+        /**
+         * Look for the evaluation of a schedule.
+         *
+         * @param   key
+         *          The hash of the schedule.
+         * @param   evaluation
+         *          Receives the evaluation, if found.
+         * @return  True if the evaluation has been found, false otherwise.
+         */
+        bool find(std::uint64_t key, std::tuple<double, double>& evaluation);
+
+        /**
+         * Store the evaluation of a schedule.
+         *
+         * @param   key
+         *          The hash of the schedule.
+         * @param   evaluation
+         *          The evaluation of the schedule.
+         */
+        void insert(std::uint64_t key, const std::tuple<double, double>& evaluation);
+
+        /**
+         * Return the number of lookups that found the evaluation.
+         *
+         * @return  The number of hits.
+         */
+        long hits() const;
+
+        /**
+         * Return the number of lookups that did not find the evaluation.
+         *
+         * @return  The number of misses.
+         */
+        long misses() const;
+
+    private:
+
+        // Entry of the table (a key equal to zero marks an empty slot)
+        struct Entry {
+            std::uint64_t key = 0;
+            double makespan = 0.0;
+            double sum_completions = 0.0;
+        };
+
+        // Number of locks guarding the table
+        static constexpr std::size_t STRIPES = 64;
+
+        int n_;
+        std::size_t mask_;
+        std::vector<Entry> table_;
+        std::mutex locks_[STRIPES];
+        std::atomic<long> hits_;
+        std::atomic<long> misses_;
+
+    };
+
+}
+
+
+#endif
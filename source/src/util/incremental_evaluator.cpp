@@ -0,0 +1,253 @@
+#include "incremental_evaluator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "common.h"
+
+
+orcs::IncrementalEvaluator::IncrementalEvaluator(const Problem& problem, EvaluationCache* cache)
+        : problem_(problem), cache_(cache), evaluation_(0.0, 0.0), feasible_(false), hash_(0) {
+
+    t_ = std::vector<double>(problem.n + 1, 0.0);
+    team_ = std::vector<int>(problem.n + 1, -1);
+    index_ = std::vector<int>(problem.n + 1, -1);
+
+    t_move_ = std::vector<double>(problem.n + 1, 0.0);
+    team_move_ = std::vector<int>(problem.n + 1, -1);
+    index_move_ = std::vector<int>(problem.n + 1, -1);
+    pendings_ = std::vector<int>(problem.n + 1, 0);
+    from_ = std::vector<int>(problem.m + 1, 0);
+    is_affected_ = std::vector<char>(problem.n + 1, 0);
+
+    affected_.reserve(problem.n + 1);
+    ready_.reserve(problem.n + 1);
+}
+
+void orcs::IncrementalEvaluator::reset(const Schedule& schedule) {
+
+    // Compute the start times from scratch
+    t_ = problem_.start_time(schedule);
+
+    // Position of each switch in the schedule
+    std::fill(team_.begin(), team_.end(), -1);
+    std::fill(index_.begin(), index_.end(), -1);
+    for (int l = 0; l <= problem_.m; ++l) {
+        for (int idx = 0; idx < schedule[l].size(); ++idx) {
+            team_[schedule[l][idx]] = l;
+            index_[schedule[l][idx]] = idx;
+        }
+    }
+
+    // Evaluate the schedule
+    double makespan = 0.0;
+    double sum_completions = 0.0;
+
+    for (int l = 1; l <= problem_.m; ++l) {
+        if (!schedule[l].empty()) {
+            int i = schedule[l][schedule[l].size() - 1];
+            makespan = std::max(makespan, t_[i] + problem_.p[i]);
+            sum_completions += t_[i] + problem_.p[i];
+        }
+    }
+
+    for (const auto& i : schedule[0]) {
+        makespan = std::max(makespan, t_[i] + problem_.p[i]);
+    }
+
+    evaluation_ = {makespan, sum_completions};
+
+    // Hash of the schedule and of the tail of each sequence, used to update
+    // the hash of the neighbors
+    if (cache_ != nullptr) {
+        suffix_hash_.resize(schedule.size());
+        hash_ = 0;
+        for (int l = 0; l < schedule.size(); ++l) {
+            suffix_hash_[l].assign(schedule[l].size() + 1, 0);
+            for (int idx = static_cast<int>(schedule[l].size()) - 1; idx >= 0; --idx) {
+                int i = (idx > 0 ? schedule[l][idx - 1] : 0);
+                suffix_hash_[l][idx] = suffix_hash_[l][idx + 1] ^ cache_->arc(i, schedule[l][idx], l);
+            }
+
+            hash_ ^= suffix_hash_[l][0];
+        }
+    }
+
+    // Incremental evaluations require all scheduled switches to have a start
+    // time (i.e., the base schedule must be feasible)
+    feasible_ = true;
+    for (int l = 0; l <= problem_.m && feasible_; ++l) {
+        for (auto i : schedule[l]) {
+            if (t_[i] == std::numeric_limits<double>::infinity()) {
+                feasible_ = false;
+                break;
+            }
+        }
+    }
+}
+
+const std::tuple<double, double>& orcs::IncrementalEvaluator::evaluation() const {
+    return evaluation_;
+}
+
+const std::vector<double>& orcs::IncrementalEvaluator::start_time() const {
+    return t_;
+}
+
+std::tuple<double, double> orcs::IncrementalEvaluator::evaluate(const Schedule& schedule,
+        int l1, int from1, int l2, int from2) {
+
+    // Look for the evaluation in the cache. Only the arcs from the changed
+    // positions onwards differ from the base schedule.
+    std::uint64_t key = 0;
+    if (cache_ != nullptr) {
+        key = hash_ ^ suffix_hash_[l1][from1] ^ cache_->hash(schedule[l1], l1, from1);
+        if (l2 >= 0) {
+            key ^= suffix_hash_[l2][from2] ^ cache_->hash(schedule[l2], l2, from2);
+        }
+
+        std::tuple<double, double> evaluation;
+        if (cache_->find(key, evaluation)) {
+            return evaluation;
+        }
+    }
+
+    // The base schedule is infeasible: evaluate the schedule from scratch
+    if (!feasible_) {
+        auto evaluation = common::evaluate(problem_, schedule);
+        if (cache_ != nullptr) {
+            cache_->insert(key, evaluation);
+        }
+
+        return evaluation;
+    }
+
+    // Initially, no switch is affected by the move
+    for (int l = 0; l <= problem_.m; ++l) {
+        from_[l] = schedule[l].size();
+    }
+
+    affected_.clear();
+
+    // Switches in the changed part of the team sequences are affected
+    mark_tail(schedule, l1, from1);
+    if (l2 >= 0) {
+        mark_tail(schedule, l2, from2);
+    }
+
+    // Switches downstream of an affected switch are affected as well. As the
+    // team sequence of a switch is followed, the affected switches of each
+    // team are always the tail of its sequence. Meanwhile, count the affected
+    // predecessors of each affected switch.
+    for (std::size_t pos = 0; pos < affected_.size(); ++pos) {
+        int i = affected_[pos];
+        for (auto j : problem_.successors[i]) {
+            if (!is_affected_[j] && team_[j] >= 0) {
+                mark_tail(schedule, team_[j], index_[j]);
+            }
+
+            if (is_affected_[j]) {
+                ++pendings_[j];
+            }
+        }
+    }
+
+    // Affected switches ready to be processed. Their start times remain
+    // infinite until they are computed.
+    ready_.clear();
+    for (auto j : affected_) {
+        if (index_move_[j] > from_[team_move_[j]]) {
+            ++pendings_[j];
+        }
+
+        if (pendings_[j] == 0) {
+            ready_.push_back(j);
+        }
+
+        t_move_[j] = std::numeric_limits<double>::infinity();
+    }
+
+    // Start time of a switch after the move
+    auto start = [this](int i) -> double {
+        return is_affected_[i] ? t_move_[i] : t_[i];
+    };
+
+    // Recompute the start times of the affected switches in topological order
+    for (std::size_t pos = 0; pos < ready_.size(); ++pos) {
+
+        // Get the switch/task
+        int j = ready_[pos];
+        int l = team_move_[j];
+        int idx = index_move_[j];
+
+        // Compute the start time
+        if (l != 0) {
+            int i = (idx > 0 ? schedule[l][idx - 1] : 0);
+            t_move_[j] = start(i) + problem_.p[i] + problem_.setup(i, j, l);
+        } else {
+            t_move_[j] = 0.0;
+        }
+
+        // Wait predecessor maneuvers
+        for (auto k : problem_.predecessors[j]) {
+            t_move_[j] = std::max(t_move_[j], start(k) + problem_.p[k]);
+        }
+
+        // Update the pending counters
+        for (auto k : problem_.successors[j]) {
+            if (is_affected_[k] && --pendings_[k] == 0) {
+                ready_.push_back(k);
+            }
+        }
+
+        if (idx + 1 < schedule[l].size()) {
+            int k = schedule[l][idx + 1];
+            if (--pendings_[k] == 0) {
+                ready_.push_back(k);
+            }
+        }
+    }
+
+    // Calculate global makespan and sum of machines' makespan. If the move
+    // created a cycle, the switches not processed have infinite start times.
+    double makespan = 0.0;
+    double sum_completions = 0.0;
+
+    for (int l = 1; l <= problem_.m; ++l) {
+        if (!schedule[l].empty()) {
+            int i = schedule[l][schedule[l].size() - 1];
+            makespan = std::max(makespan, start(i) + problem_.p[i]);
+            sum_completions += start(i) + problem_.p[i];
+        }
+    }
+
+    for (const auto& i : schedule[0]) {
+        makespan = std::max(makespan, start(i) + problem_.p[i]);
+    }
+
+    // Clear the workspace
+    for (auto j : affected_) {
+        is_affected_[j] = 0;
+        pendings_[j] = 0;
+    }
+
+    // Store the evaluation in the cache
+    if (cache_ != nullptr) {
+        cache_->insert(key, {makespan, sum_completions});
+    }
+
+    return {makespan, sum_completions};
+}
+
+void orcs::IncrementalEvaluator::mark_tail(const Schedule& schedule, int l, int from) {
+    for (int idx = from; idx < from_[l]; ++idx) {
+        int j = schedule[l][idx];
+        is_affected_[j] = 1;
+        team_move_[j] = l;
+        index_move_[j] = idx;
+        affected_.push_back(j);
+    }
+
+    from_[l] = std::min(from_[l], from);
+}
@@ -0,0 +1,123 @@
+#ifndef MANEUVER_SCHEDULING_INCREMENTAL_EVALUATOR_H
+#define MANEUVER_SCHEDULING_INCREMENTAL_EVALUATOR_H
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "../problem/problem.h"
+#include "evaluation_cache.h"
+
+
+namespace orcs {
+
+    /**
+     * Evaluates schedules that differ from a base schedule on a few team
+     * sequences. The start times of the base schedule are cached, so only the
+     * start times of the switches placed downstream of the changed positions
+     * (following the team sequences and the precedence graph) are recomputed.
+     * The evaluation returned is the same computed by common::evaluate().
+     * Optionally, evaluations are looked up in (and stored into) an
+     * evaluation cache, using hashes updated from the changed positions.
+     */
+    class IncrementalEvaluator {
+
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param   problem
+         *          Instance of the problem being optimized.
+         * @param   cache
+         *          Cache of evaluations, or nullptr to disable caching.
+         */
+        explicit IncrementalEvaluator(const Problem& problem, EvaluationCache* cache = nullptr);
+
+        /**
+         * Set the base schedule. Its start times are fully computed and cached
+         * for further incremental evaluations.
+         *
+         * @param   schedule
+         *          The base schedule.
+         */
+        void reset(const Schedule& schedule);
+
+        /**
+         * Return the evaluation of the base schedule.
+         *
+         * @return  A tuple containing the makespan and the sum of the
+         *          completion times of the base schedule.
+         */
+        const std::tuple<double, double>& evaluation() const;
+
+        /**
+         * Return the start times of the base schedule.
+         *
+         * @return  A vector with start times, in which the i-th value is the
+         *          start time of the i-th switch.
+         */
+        const std::vector<double>& start_time() const;
+
+        /**
+         * Evaluate a schedule obtained from the base schedule by a move. The
+         * move is described by the teams whose sequences have been changed and
+         * the first index of each sequence that may differ from the base
+         * schedule. All switches must be kept in the schedule (i.e., a move can
+         * only reorder or reassign switches).
+         *
+         * @param   schedule
+         *          The schedule to evaluate (i.e., the base schedule after
+         *          the move).
+         * @param   l1
+         *          The first team changed by the move.
+         * @param   from1
+         *          The first index of the sequence of team l1 changed by the
+         *          move.
+         * @param   l2
+         *          The second team changed by the move, or -1 if the move
+         *          changes a single team.
+         * @param   from2
+         *          The first index of the sequence of team l2 changed by the
+         *          move. Ignored if l2 is -1.
+         * @return  A tuple with two values, in which the first is the
+         *          makespan and the second is the sum of completion times of
+         *          the work of all teams (including the dummy team).
+         */
+        std::tuple<double, double> evaluate(const Schedule& schedule,
+                int l1, int from1, int l2 = -1, int from2 = -1);
+
+    private:
+
+        const Problem& problem_;
+        EvaluationCache* cache_;
+
+        // Data of the base schedule
+        std::vector<double> t_;
+        std::vector<int> team_;
+        std::vector<int> index_;
+        std::tuple<double, double> evaluation_;
+        bool feasible_;
+        std::uint64_t hash_;
+        std::vector< std::vector<std::uint64_t> > suffix_hash_;
+
+        // Workspace used by incremental evaluations
+        std::vector<double> t_move_;
+        std::vector<int> team_move_;
+        std::vector<int> index_move_;
+        std::vector<int> pendings_;
+        std::vector<int> from_;
+        std::vector<int> affected_;
+        std::vector<int> ready_;
+        std::vector<char> is_affected_;
+
+        // Mark the switches of the sequence of team l from index from onwards
+        // as affected by the move
+        void mark_tail(const Schedule& schedule, int l, int from);
+
+    };
+
+}
+
+
+#endif
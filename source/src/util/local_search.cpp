@@ -4,6 +4,7 @@
 #include <chrono>
 #include <cmath>
 #include <limits>
+#include <numeric>
 #include <vector>
 
 #include "common.h"
@@ -39,12 +40,15 @@ orcs::local_search::standard(const Problem& problem,
 std::tuple< orcs::Schedule, std::tuple<double, double> >
 orcs::local_search::vnd(const Problem& problem,
         const std::tuple< orcs::Schedule, std::tuple<double, double> >& entry,
-        std::list<Neighborhood*>& neighborhoods) {
+        std::list<Neighborhood*>& neighborhoods,
+        int* improving) {
 
     // Keep the best solution found
     auto incumbent = entry;
+    int last_improving = -1;
 
     // Perform the local search
+    int position = 0;
     auto k = neighborhoods.begin();
     while (k != neighborhoods.end()) {
 
@@ -59,17 +63,24 @@ orcs::local_search::vnd(const Problem& problem,
 
             // Update the incumbent solution
             incumbent = std::move(trial);
+            last_improving = position;
 
             // Go to the first neighborhood
             k = neighborhoods.begin();
+            position = 0;
 
         } else {
 
             // Go to the next neighborhood
             ++k;
+            ++position;
         }
     }
 
+    if (improving != nullptr) {
+        *improving = last_improving;
+    }
+
     // Return the best solution found
     return incumbent;
 }
@@ -78,7 +89,8 @@ std::tuple< orcs::Schedule, std::tuple<double, double> >
 orcs::local_search::rvnd(const Problem& problem,
         const std::tuple< orcs::Schedule, std::tuple<double, double> >& entry,
         std::list<Neighborhood*>& neighborhoods,
-        std::mt19937* generator) {
+        std::mt19937* generator,
+        int* improving) {
 
     // Random number generator
     std::mt19937 inner_generator(std::chrono::system_clock::now().time_since_epoch().count());
@@ -86,11 +98,14 @@ orcs::local_search::rvnd(const Problem& problem,
         generator = &inner_generator;
     }
 
-    // List of neighborhoods available
+    // List of neighborhoods available (and their positions in the list)
     std::vector<Neighborhood*> available_neighborhoods(neighborhoods.begin(), neighborhoods.end());
+    std::vector<int> available_positions(neighborhoods.size());
+    std::iota(available_positions.begin(), available_positions.end(), 0);
 
     // Keep the best solution found
     auto incumbent = entry;
+    int last_improving = -1;
 
     // Perform the local search
     while (!available_neighborhoods.empty()) {
@@ -98,7 +113,9 @@ orcs::local_search::rvnd(const Problem& problem,
         // Choose a neighborhood
         int idx = (*generator)() % available_neighborhoods.size();
         Neighborhood* neighborhood = *(available_neighborhoods.begin() + idx);
+        int position = available_positions[idx];
         available_neighborhoods.erase(available_neighborhoods.begin() + idx);
+        available_positions.erase(available_positions.begin() + idx);
 
         // Get a neighbor
         auto trial = neighborhood->best(problem, incumbent);
@@ -108,14 +125,33 @@ orcs::local_search::rvnd(const Problem& problem,
 
             // Update the incumbent solution
             incumbent = std::move(trial);
+            last_improving = position;
 
             // Reset the list of available neighborhoods
             available_neighborhoods.clear();
             available_neighborhoods.insert(available_neighborhoods.begin(), neighborhoods.begin(), neighborhoods.end());
+            available_positions.resize(neighborhoods.size());
+            std::iota(available_positions.begin(), available_positions.end(), 0);
 
         }
     }
 
+    if (improving != nullptr) {
+        *improving = last_improving;
+    }
+
     // Return the best solution found
     return incumbent;
 }
+
+orcs::Approach orcs::local_search::approach(const std::string& name) {
+    if (name == "best") {
+        return Approach::BEST;
+    } else if (name == "first") {
+        return Approach::FIRST;
+    } else if (name == "sampled") {
+        return Approach::SAMPLED;
+    }
+
+    throw std::string("Invalid local search approach \"" + name + "\".");
+}
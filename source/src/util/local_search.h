@@ -3,6 +3,7 @@
 
 #include <list>
 #include <random>
+#include <string>
 #include "../algorithm/algorithm.h"
 #include "../neighborhood/neighborhood.h"
 #include "../problem/problem.h"
@@ -41,6 +42,10 @@ namespace orcs {
          *          The start entry to perform the local search.
          * @param   neighborhoods
          *          List of neighborhood structures.
+         * @param   improving
+         *          If not nullptr, it receives the position (in the list) of
+         *          the neighborhood of the last improving move, or -1 if the
+         *          start entry is a local optimum.
          *
          * @return  A tuple of two elements, in which the first is the
          *          schedule, the second is its evaluation (i.e., a tuple
@@ -49,7 +54,8 @@ namespace orcs {
         std::tuple<orcs::Schedule, std::tuple<double, double> >
         vnd(const Problem &problem,
             const std::tuple<orcs::Schedule, std::tuple<double, double> > &entry,
-            std::list<Neighborhood *> &neighborhoods);
+            std::list<Neighborhood *> &neighborhoods,
+            int *improving = nullptr);
 
         /**
          * Perform the local search according to randomized variable neighborhood
@@ -63,6 +69,10 @@ namespace orcs {
          *          List of neighborhood structures.
          * @param   generator
          *          Random number generator.
+         * @param   improving
+         *          If not nullptr, it receives the position (in the list) of
+         *          the neighborhood of the last improving move, or -1 if the
+         *          start entry is a local optimum.
          *
          * @return  A tuple of two elements, in which the first is the
          *          schedule, the second is its evaluation (i.e., a tuple
@@ -72,7 +82,19 @@ namespace orcs {
         rvnd(const Problem &problem,
              const std::tuple<orcs::Schedule, std::tuple<double, double> > &entry,
              std::list<Neighborhood *> &neighborhoods,
-             std::mt19937 *generator = nullptr);
+             std::mt19937 *generator = nullptr,
+             int *improving = nullptr);
+
+        /**
+         * Return the approach to explore the neighborhoods given its name.
+         *
+         * @param   name
+         *          Name of the approach ("best", "first" or "sampled").
+         *
+         * @return  The approach. An exception is thrown if the name is
+         *          invalid.
+         */
+        Approach approach(const std::string &name);
 
     }
 }
@@ -0,0 +1,96 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+
+
+orcs::ThreadPool::ThreadPool(int threads) : size_(threads), stop_(false) {
+
+    // Number of threads (0 means all threads available)
+    if (size_ <= 0) {
+        size_ = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+    // The thread calling run() also works, so one thread less is created
+    for (int k = 1; k < size_; ++k) {
+        workers_.emplace_back([this]() {
+            while (true) {
+
+                // Wait for a job
+                std::function<void()> job;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    condition_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+                    if (stop_ && queue_.empty()) {
+                        return;
+                    }
+
+                    job = std::move(queue_.front());
+                    queue_.pop();
+                }
+
+                // Run the job
+                job();
+            }
+        });
+    }
+}
+
+orcs::ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+
+    condition_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void orcs::ThreadPool::run(int tasks, const std::function<void(int)>& task) {
+
+    // State of the batch
+    std::atomic<int> next(0);
+    int pending = 0;
+    std::mutex batch_mutex;
+    std::condition_variable batch_condition;
+
+    // Each job runs tasks of the batch until none is left
+    auto work = [&]() {
+        for (int k = next++; k < tasks; k = next++) {
+            task(k);
+        }
+    };
+
+    // Jobs run by the workers
+    int helpers = std::min(size_, tasks) - 1;
+    if (helpers > 0) {
+        pending = helpers;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (int k = 0; k < helpers; ++k) {
+                queue_.push([&]() {
+                    work();
+                    std::lock_guard<std::mutex> batch_lock(batch_mutex);
+                    if (--pending == 0) {
+                        batch_condition.notify_one();
+                    }
+                });
+            }
+        }
+
+        condition_.notify_all();
+    }
+
+    // The calling thread works as well
+    work();
+
+    // Wait for the workers
+    std::unique_lock<std::mutex> lock(batch_mutex);
+    batch_condition.wait(lock, [&]() { return pending == 0; });
+}
+
+int orcs::ThreadPool::size() const {
+    return size_;
+}
@@ -0,0 +1,75 @@
+#ifndef MANEUVER_SCHEDULING_THREAD_POOL_H
+#define MANEUVER_SCHEDULING_THREAD_POOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+
+namespace orcs {
+
+    /**
+     * Fixed-size pool of threads used to run batches of independent tasks.
+     * The pool can be shared by several threads: each call to run() waits
+     * only for the tasks of its own batch.
+     */
+    class ThreadPool {
+
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param   threads
+         *          Number of threads used to run the tasks, including the
+         *          thread that calls run(). If set to 0 (zero), all threads
+         *          available are used.
+         */
+        explicit ThreadPool(int threads);
+
+        /**
+         * Destructor. Wait for the workers to finish.
+         */
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * Run a batch of tasks and wait for all of them to finish. The calling
+         * thread also runs tasks of the batch.
+         *
+         * @param   tasks
+         *          Number of tasks.
+         * @param   task
+         *          Function called once for each task, with the index of the
+         *          task (from 0 to tasks - 1).
+         */
+        void run(int tasks, const std::function<void(int)>& task);
+
+        /**
+         * Return the number of threads used to run the tasks (including the
+         * thread that calls run()).
+         *
+         * @return  The number of threads.
+         */
+        int size() const;
+
+    private:
+
+        int size_;
+        bool stop_;
+        std::vector<std::thread> workers_;
+        std::queue< std::function<void()> > queue_;
+        std::mutex mutex_;
+        std::condition_variable condition_;
+
+    };
+
+}
+
+
+#endif
@@ -0,0 +1,137 @@
+#include "time_windows.h"
+
+#include <algorithm>
+#include <limits>
+
+
+orcs::TimeWindows::TimeWindows(const Problem& problem, double upper_bound) : upper_bound_(upper_bound) {
+
+    // Get problem data
+    auto n = problem.n;
+    auto m = problem.m;
+    const auto& p = problem.p;
+    const auto& technology = problem.technology;
+
+    auto is_manual = [&technology](int i) -> bool {
+        return i == 0 || technology[i] != Technology::REMOTE;
+    };
+
+    // Shortest setup time of each arc (i, j) among all teams
+    std::vector<double> min_setup((n + 1) * (n + 1), 0.0);
+    for (int i = 0; i <= n; ++i) {
+        for (int j = 1; j <= n; ++j) {
+            double setup = std::numeric_limits<double>::infinity();
+            for (int l = 1; l <= m; ++l) {
+                setup = std::min(setup, problem.setup(i, j, l));
+            }
+            min_setup[i * (n + 1) + j] = setup;
+        }
+    }
+
+    // Shortest setup time before a manual switch. The switch maneuvered
+    // before it cannot be one of its successors.
+    std::vector<double> min_setup_in(n + 1, 0.0);
+    for (int j = 1; j <= n; ++j) {
+        if (is_manual(j)) {
+            min_setup_in[j] = min_setup[j];
+            for (int i = 1; i <= n; ++i) {
+                if (i != j && is_manual(i) && !problem.precedence(j, i)) {
+                    min_setup_in[j] = std::min(min_setup_in[j], min_setup[i * (n + 1) + j]);
+                }
+            }
+        }
+    }
+
+    // Work of the manual ancestors and descendants of each switch, shared by
+    // the teams
+    std::vector<double> ancestors_work(n + 1, 0.0);
+    std::vector<double> descendants_work(n + 1, 0.0);
+    for (int i = 1; i <= n; ++i) {
+        for (int k = 1; k <= n; ++k) {
+            if (k != i && technology[k] != Technology::REMOTE) {
+                if (problem.precedence(k, i)) {
+                    ancestors_work[i] += p[k] + min_setup_in[k];
+                }
+
+                if (problem.precedence(i, k)) {
+                    descendants_work[i] += p[k];
+                }
+            }
+        }
+
+        ancestors_work[i] /= m;
+        descendants_work[i] /= m;
+    }
+
+    // Heads: the bounds depend on each other, so they are raised until a
+    // fixed point is reached. All intermediate values are valid bounds.
+    head_ = ancestors_work;
+    bool changed = true;
+    for (int round = 0; changed && round <= n + 1; ++round) {
+        changed = false;
+        for (int j = 1; j <= n; ++j) {
+            double head = head_[j];
+
+            // Wait predecessor maneuvers
+            for (auto k : problem.predecessors[j]) {
+                head = std::max(head, head_[k] + p[k]);
+            }
+
+            // Reach the switch from the depot or from another switch
+            if (technology[j] != Technology::REMOTE) {
+                double arrival = min_setup[j];
+                for (int i = 1; i <= n; ++i) {
+                    if (i != j && is_manual(i) && !problem.precedence(j, i)) {
+                        arrival = std::min(arrival, head_[i] + p[i] + min_setup[i * (n + 1) + j]);
+                    }
+                }
+                head = std::max(head, arrival);
+            }
+
+            if (head > head_[j]) {
+                head_[j] = head;
+                changed = true;
+            }
+        }
+    }
+
+    // Tails
+    tail_ = descendants_work;
+    changed = true;
+    for (int round = 0; changed && round <= n + 1; ++round) {
+        changed = false;
+        for (int i = 1; i <= n; ++i) {
+            double tail = tail_[i];
+            for (auto k : problem.successors[i]) {
+                tail = std::max(tail, p[k] + tail_[k]);
+            }
+
+            if (tail > tail_[i]) {
+                tail_[i] = tail;
+                changed = true;
+            }
+        }
+    }
+
+    // Latest start times
+    latest_ = std::vector<double>(n + 1, upper_bound);
+    for (int i = 1; i <= n; ++i) {
+        latest_[i] = upper_bound - tail_[i] - p[i];
+    }
+}
+
+double orcs::TimeWindows::upper_bound() const {
+    return upper_bound_;
+}
+
+double orcs::TimeWindows::earliest(int i) const {
+    return head_[i];
+}
+
+double orcs::TimeWindows::latest(int i) const {
+    return latest_[i];
+}
+
+double orcs::TimeWindows::tail(int i) const {
+    return tail_[i];
+}
@@ -0,0 +1,88 @@
+#ifndef MANEUVER_SCHEDULING_TIME_WINDOWS_H
+#define MANEUVER_SCHEDULING_TIME_WINDOWS_H
+
+#include <vector>
+
+#include "../problem/problem.h"
+
+
+namespace orcs {
+
+    /**
+     * Earliest and latest start times of the switches in any schedule whose
+     * makespan does not exceed an upper bound.
+     *
+     * The head of a switch is a lower bound on its start time. It is the
+     * largest of: (1) the completion time of the head of each predecessor;
+     * (2) for manual switches, the shortest time a team takes to reach the
+     * switch, from the depot or after maneuvering another switch that is not
+     * a successor; and (3) the processing and setup times of all manual
+     * ancestors in the precedence closure, shared by the m teams.
+     *
+     * The tail of a switch is a lower bound on the time between its
+     * completion and the makespan. It is the largest of: (1) the processing
+     * time plus the tail of each successor; and (2) the processing times of
+     * all manual descendants, shared by the m teams.
+     */
+    class TimeWindows {
+
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param   problem
+         *          The instance of the problem.
+         * @param   upper_bound
+         *          An upper bound on the makespan (e.g., the makespan of a
+         *          heuristic solution).
+         */
+        TimeWindows(const Problem& problem, double upper_bound);
+
+        /**
+         * Return the upper bound on the makespan used to compute the latest
+         * start times.
+         */
+        double upper_bound() const;
+
+        /**
+         * Return the head of a switch (its earliest start time).
+         *
+         * @param   i
+         *          The switch.
+         * @return  The earliest start time of the switch.
+         */
+        double earliest(int i) const;
+
+        /**
+         * Return the latest start time of a switch, i.e., the upper bound
+         * minus its tail and processing time.
+         *
+         * @param   i
+         *          The switch.
+         * @return  The latest start time of the switch.
+         */
+        double latest(int i) const;
+
+        /**
+         * Return the tail of a switch.
+         *
+         * @param   i
+         *          The switch.
+         * @return  The tail of the switch.
+         */
+        double tail(int i) const;
+
+    private:
+
+        double upper_bound_;
+        std::vector<double> head_;
+        std::vector<double> tail_;
+        std::vector<double> latest_;
+
+    };
+
+}
+
+
+#endif
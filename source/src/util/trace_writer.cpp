@@ -0,0 +1,149 @@
+#include "trace_writer.h"
+
+#include <chrono>
+#include <string>
+#include <utility>
+
+#include "common.h"
+
+
+namespace {
+
+    // Quote a string as a JSON string literal (escaping quotes, backslashes
+    // and control characters)
+    std::string json_string(const std::string& str) {
+        std::string quoted = "\"";
+        for (char c : str) {
+            switch (c) {
+                case '"':  quoted += "\\\""; break;
+                case '\\': quoted += "\\\\"; break;
+                case '\b': quoted += "\\b"; break;
+                case '\f': quoted += "\\f"; break;
+                case '\n': quoted += "\\n"; break;
+                case '\r': quoted += "\\r"; break;
+                case '\t': quoted += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        quoted += orcs::common::format("\\u%04x", static_cast<unsigned>(c));
+                    } else {
+                        quoted += c;
+                    }
+            }
+        }
+
+        return quoted + "\"";
+    }
+
+    // Quote a CSV field (RFC 4180) if it contains a separator, a quote or a
+    // line break, doubling the quotes in it
+    std::string csv_field(const std::string& str) {
+        if (str.find_first_of(",\"\r\n") == std::string::npos) {
+            return str;
+        }
+
+        std::string quoted = "\"";
+        for (char c : str) {
+            quoted += c;
+            if (c == '"') {
+                quoted += '"';
+            }
+        }
+
+        return quoted + "\"";
+    }
+
+}
+
+
+orcs::TraceWriter::TraceWriter(const std::string& filename, const std::string& format, std::size_t capacity) :
+        json_(format == "json"), capacity_(capacity), closing_(false) {
+
+    if (format != "csv" && format != "json") {
+        throw std::string("Invalid trace format \"" + format + "\".");
+    }
+
+    file_.open(filename);
+    if (!file_.is_open()) {
+        throw std::string("File \"" + filename + "\" cannot be opened.");
+    }
+
+    if (!json_) {
+        file_ << "INSTANCE,SEED,TIME.SEC,ITERATION,WORKER,MAKESPAN,SUM.COMPLETIONS,NEIGHBORHOOD" << std::endl;
+    }
+
+    buffer_.reserve(capacity_);
+    thread_ = std::thread(&TraceWriter::run, this);
+}
+
+orcs::TraceWriter::~TraceWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closing_ = true;
+    }
+
+    condition_.notify_one();
+    thread_.join();
+}
+
+void orcs::TraceWriter::record(Event event) {
+    bool full;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffer_.push_back(std::move(event));
+        full = buffer_.size() >= capacity_;
+    }
+
+    if (full) {
+        condition_.notify_one();
+    }
+}
+
+void orcs::TraceWriter::write(const std::vector<Event>& events) {
+    for (const auto& event : events) {
+
+        // The string fields are quoted apart from the formatted numbers
+        if (json_) {
+            file_ << "{\"instance\": " << json_string(event.instance)
+                  << common::format(", \"seed\": %d, \"time\": %.4lf, \"iteration\": %ld, \"worker\": %d, "
+                                    "\"makespan\": %.6lf, \"sum_completions\": %.6lf, \"neighborhood\": ",
+                                    event.seed, event.time, event.iteration, event.worker,
+                                    event.makespan, event.sum_completions)
+                  << json_string(event.neighborhood) << "}\n";
+        } else {
+            file_ << csv_field(event.instance)
+                  << common::format(",%d,%.4lf,%ld,%d,%.6lf,%.6lf,",
+                                    event.seed, event.time, event.iteration, event.worker,
+                                    event.makespan, event.sum_completions)
+                  << csv_field(event.neighborhood) << '\n';
+        }
+    }
+
+    file_.flush();
+}
+
+void orcs::TraceWriter::run() {
+    std::vector<Event> events;
+    events.reserve(capacity_);
+
+    bool closing = false;
+    while (!closing) {
+
+        // Wait until the buffer is full, the writer is closed or a second has
+        // passed, and take the pending events
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait_for(lock, std::chrono::seconds(1), [this]() {
+                return closing_ || buffer_.size() >= capacity_;
+            });
+
+            events.swap(buffer_);
+            closing = closing_;
+        }
+
+        // Write them out of the lock
+        if (!events.empty()) {
+            write(events);
+            events.clear();
+        }
+    }
+}
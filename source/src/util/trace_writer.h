@@ -0,0 +1,92 @@
+#ifndef MANEUVER_SCHEDULING_TRACE_WRITER_H
+#define MANEUVER_SCHEDULING_TRACE_WRITER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace orcs {
+
+    /**
+     * Thread-safe sink of the improvements of the incumbent solution found by
+     * an algorithm, written as CSV rows or JSON lines to a file. Events are
+     * only appended to an in-memory buffer by record(); formatting and I/O are
+     * performed by a background thread, which drains the buffer when it is
+     * full or periodically, so the trace can be followed while the algorithm
+     * runs.
+     */
+    class TraceWriter {
+
+    public:
+
+        /**
+         * Improvement of the incumbent solution.
+         */
+        struct Event {
+            std::string instance;       // Name of the instance
+            int seed = 0;               // Seed of the run
+            double time = 0.0;          // Time since the start of the run (s)
+            long iteration = 0;         // Iteration of the algorithm
+            int worker = 0;             // Worker (thread) that found the solution
+            double makespan = 0.0;
+            double sum_completions = 0.0;
+            std::string neighborhood;   // Neighborhood of the last improving move
+        };
+
+        /**
+         * Constructor.
+         *
+         * @param   filename
+         *          Path to the file to write.
+         * @param   format
+         *          Format of the file: "csv" or "json" (JSON lines).
+         * @param   capacity
+         *          Number of buffered events that triggers a write.
+         */
+        TraceWriter(const std::string& filename, const std::string& format = "csv", std::size_t capacity = 1024);
+
+        /**
+         * Destructor. Write the pending events and close the file.
+         */
+        ~TraceWriter();
+
+        TraceWriter(const TraceWriter&) = delete;
+        TraceWriter& operator=(const TraceWriter&) = delete;
+
+        /**
+         * Append an event to the buffer.
+         *
+         * @param   event
+         *          The event.
+         */
+        void record(Event event);
+
+    private:
+
+        void write(const std::vector<Event>& events);
+
+        void run();
+
+        std::ofstream file_;
+        bool json_;
+        std::size_t capacity_;
+
+        // Events not written yet
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        std::vector<Event> buffer_;
+        bool closing_;
+
+        std::thread thread_;
+
+    };
+
+}
+
+
+#endif